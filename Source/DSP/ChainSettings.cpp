@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    ChainSettings.cpp
+    Created: 17 Oct 2026 1:05:38pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "ChainSettings.h"
+#include "ParameterRanges.h"
+
+void getLowCutSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings)
+{
+    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
+    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
+    settings.lowCutBypassed = apvts.getRawParameterValue("LowCut Bypassed")->load() > 0.5f;
+}
+
+void getPeakSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings)
+{
+    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
+    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
+    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
+    settings.peakBypassed = apvts.getRawParameterValue("Peak Bypassed")->load() > 0.5f;
+}
+
+void getHighCutSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings)
+{
+    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
+    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
+    settings.highCutBypassed = apvts.getRawParameterValue("HighCut Bypassed")->load() > 0.5f;
+}
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+{
+    ChainSettings settings;
+    getLowCutSettings(apvts, settings);
+    getPeakSettings(apvts, settings);
+    getHighCutSettings(apvts, settings);
+    
+    settings.analyzerEnabled = apvts.getRawParameterValue("Analyzer Enabled")->load() > 0.5f;
+    
+    return settings;
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowCut Freq", 1),
+                                                           "LowCut Freq",
+                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
+                                                           MIN_FREQUENCY));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighCut Freq", 1),
+                                                           "HighCut Freq",
+                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
+                                                           MAX_FREQUENCY));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Freq", 1),
+                                                           "Peak Freq",
+                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
+                                                           750.f));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Gain", 1),
+                                                           "Peak Gain",
+                                                           juce::NormalisableRange<float>(MIN_GAIN, MAX_GAIN, 1.f, 1.f),
+                                                           0.f));
+    
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Quality", 1),
+                                                           "Peak Quality",
+                                                           juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
+                                                           1.f));
+    
+    juce::StringArray stringArray;
+    for (int i = 0; i < 4; ++i) {
+        juce::String str;
+        str << (12 + i * 12);
+        str << " db/Oct";
+        stringArray.add(str);
+    }
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("LowCut Slope", 1), "LowCut Slope", stringArray, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("HighCut Slope", 1), "HighCut Slope", stringArray, 0));
+        
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("LowCut Bypassed", 1), "LowCut Bypassed", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Peak Bypassed", 1), "Peak Bypassed", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("HighCut Bypassed", 1), "HighCut Bypassed", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Analyzer Enabled", 1), "Analyser Enabled", true));
+    
+    // the analyzer's resolution and window, display only like the mode
+    juce::StringArray analyzerFFTSizeChoices { "2048", "4096", "8192", "16384", "32768" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer FFT Size", 1), "Analyzer FFT Size", analyzerFFTSizeChoices, 3,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    juce::StringArray analyzerWindowChoices { "Blackman-Harris", "Hann", "Flat Top" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Window", 1), "Analyzer Window", analyzerWindowChoices, 0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // whether the analyzer's bands line up for sines or for noise, a display setting like the mode
+    juce::StringArray analyzerCalibrationChoices { "Sine", "Noise" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Calibration", 1), "Analyzer Calibration", analyzerCalibrationChoices, 0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // only changes what the editor shows, so it's saved with the state but kept out of the hosts' automation lanes
+    juce::StringArray analyzerModeChoices { "Left / Right", "Mid / Side", "Mono Sum" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Mode", 1), "Analyzer Mode", analyzerModeChoices, 0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // how much consecutive analyzer windows overlap, the analyzer never does more than one per refresh anyway.
+    // display only, like the mode
+    juce::StringArray analyzerOverlapChoices { "0%", "50%", "75%", "87.5%" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Overlap", 1), "Analyzer Overlap", analyzerOverlapChoices, 1,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // how the traces get steadied, display only like the mode
+    juce::StringArray analyzerAveragingChoices { "Off", "Exponential", "Welch" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Averaging", 1), "Analyzer Averaging", analyzerAveragingChoices, 1,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // the averaging time constant, or how many frames Welch averages
+    juce::StringArray analyzerResponseChoices { "Fast", "Medium", "Slow" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer Response", 1), "Analyzer Response", analyzerResponseChoices, 1,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Analyzer Peak Hold", 1), "Analyzer Peak Hold", false,
+                                                          juce::AudioParameterBoolAttributes().withAutomatable(false)));
+    
+    // only what the editor draws, so like the mode it stays out of the automation lanes
+    juce::StringArray analyzerViewChoices { "Lines", "Spectrogram" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Analyzer View", 1), "Analyzer View", analyzerViewChoices, 0,
+                                                            juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // how often the coefficients get redesigned while gliding, they're ramped in between
+    juce::StringArray smoothingChoices { "Off", "16 Samples", "32 Samples", "64 Samples" };
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Smoothing", 1), "Smoothing", smoothingChoices, 2));
+    
+    return layout;
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    ChainSettings.h
+    Created: 17 Oct 2026 9:12:04am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+struct ChainSettings
+{
+    float peakFreq { 0 }, peakGainInDecibels { 0 }, peakQuality { 1.f };
+    float lowCutFreq { 0 }, highCutFreq { 0 };
+    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+    bool lowCutBypassed { false }, peakBypassed { false }, highCutBypassed { false }, analyzerEnabled { true };
+};
+
+enum ChainPositions
+{
+    LowCut,
+    Peak,
+    HighCut,
+    NumChainPositions
+};
+
+/** every parameter of the plugin. lives here so tools can build an APVTS without the processor. */
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+
+// these only read the parameters of one band, so unchanged bands can be skipped.
+void getLowCutSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings);
+void getPeakSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings);
+void getHighCutSettings(juce::AudioProcessorValueTreeState& apvts, ChainSettings& settings);
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.cpp
+    Created: 17 Oct 2026 9:31:12am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+
+namespace
+{
+/*
+ Same formulas as juce::dsp::IIR::Coefficients::makeLowPass / makeHighPass / makePeakFilter,
+ but computed in double and written straight into a BiquadCoefficients.
+ Nothing here allocates, so these are safe to call on the audio thread while smoothing.
+ */
+BiquadCoefficients makeLowPass(double sampleRate, double frequency, double Q)
+{
+    auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    auto nSquared = n * n;
+    auto invQ = 1.0 / Q;
+    auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+    return { static_cast<float>(c1),
+             static_cast<float>(c1 * 2.0),
+             static_cast<float>(c1),
+             static_cast<float>(c1 * 2.0 * (1.0 - nSquared)),
+             static_cast<float>(c1 * (1.0 - invQ * n + nSquared)) };
+}
+
+BiquadCoefficients makeHighPass(double sampleRate, double frequency, double Q)
+{
+    auto n = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+    auto nSquared = n * n;
+    auto invQ = 1.0 / Q;
+    auto c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+    return { static_cast<float>(c1),
+             static_cast<float>(c1 * -2.0),
+             static_cast<float>(c1),
+             static_cast<float>(c1 * 2.0 * (nSquared - 1.0)),
+             static_cast<float>(c1 * (1.0 - invQ * n + nSquared)) };
+}
+
+BiquadCoefficients makePeak(double sampleRate, double frequency, double Q, double gainFactor)
+{
+    auto A = std::sqrt(juce::jmax(0.0, gainFactor));
+    auto omega = (juce::MathConstants<double>::twoPi * juce::jmax(frequency, 2.0)) / sampleRate;
+    auto alpha = std::sin(omega) / (Q * 2.0);
+    auto c2 = -2.0 * std::cos(omega);
+    auto alphaTimesA = alpha * A;
+    auto alphaOverA = alpha / A;
+    auto a0 = 1.0 + alphaOverA;
+
+    return { static_cast<float>((1.0 + alphaTimesA) / a0),
+             static_cast<float>(c2 / a0),
+             static_cast<float>((1.0 - alphaTimesA) / a0),
+             static_cast<float>(c2 / a0),
+             static_cast<float>((1.0 - alphaOverA) / a0) };
+}
+
+/** Q of section 'index' in an even order Butterworth cascade, as juce::dsp::FilterDesign does it. */
+double getButterworthQ(int index, int order)
+{
+    return 1.0 / (2.0 * std::cos((2.0 * index + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+}
+
+template<typename MakeSection>
+void designCut(CutCoefficients& cut, Slope slope, bool bypassed, MakeSection&& makeSection)
+{
+    cut.slope = slope;
+    cut.bypassed = bypassed;
+
+    // 1 section = 12db, so a 2 * numSections order Butterworth
+    const auto numSections = cut.getNumSections();
+    for( int i = 0; i < numSections; ++i )
+        cut.sections[i] = makeSection(getButterworthQ(i, 2 * numSections));
+}
+}
+
+void designLowCut(CutCoefficients& lowCut, const ChainSettings& chainSettings, double sampleRate,
+                  const CutCoefficientTable* table)
+{
+    jassert(table == nullptr || table->getSampleRate() == sampleRate);
+
+    if( table != nullptr && table->lookupLowCut(lowCut, chainSettings.lowCutFreq, chainSettings.lowCutSlope) )
+    {
+        lowCut.slope = chainSettings.lowCutSlope;
+        lowCut.bypassed = chainSettings.lowCutBypassed;
+        return;
+    }
+
+    designCut(lowCut, chainSettings.lowCutSlope, chainSettings.lowCutBypassed, [&](double Q)
+    {
+        return makeHighPass(sampleRate, chainSettings.lowCutFreq, Q);
+    });
+}
+
+void designPeak(FilterCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate)
+{
+    coefficients.peak = makePeak(sampleRate,
+                                 chainSettings.peakFreq,
+                                 chainSettings.peakQuality,
+                                 juce::Decibels::decibelsToGain(static_cast<double>(chainSettings.peakGainInDecibels)));
+    coefficients.peakBypassed = chainSettings.peakBypassed;
+}
+
+void designHighCut(CutCoefficients& highCut, const ChainSettings& chainSettings, double sampleRate,
+                   const CutCoefficientTable* table)
+{
+    jassert(table == nullptr || table->getSampleRate() == sampleRate);
+
+    if( table != nullptr && table->lookupHighCut(highCut, chainSettings.highCutFreq, chainSettings.highCutSlope) )
+    {
+        highCut.slope = chainSettings.highCutSlope;
+        highCut.bypassed = chainSettings.highCutBypassed;
+        return;
+    }
+
+    designCut(highCut, chainSettings.highCutSlope, chainSettings.highCutBypassed, [&](double Q)
+    {
+        return makeLowPass(sampleRate, chainSettings.highCutFreq, Q);
+    });
+}
+
+FilterCoefficients designFilterCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+    FilterCoefficients result;
+    result.sampleRate = sampleRate;
+    result.settings = chainSettings;
+
+    designLowCut(result.lowCut, chainSettings, sampleRate);
+    designPeak(result, chainSettings, sampleRate);
+    designHighCut(result.highCut, chainSettings, sampleRate);
+
+    return result;
+}
+
+int getBandForParameter(const juce::String& parameterID)
+{
+    if( parameterID.startsWith("LowCut") )
+        return ChainPositions::LowCut;
+    if( parameterID.startsWith("Peak") )
+        return ChainPositions::Peak;
+    if( parameterID.startsWith("HighCut") )
+        return ChainPositions::HighCut;
+
+    return -1;
+}
+
+//==============================================================================
+CoefficientDesigner::CoefficientDesigner(juce::AudioProcessorValueTreeState& state) :
+juce::Thread("Coefficient Designer"),
+apvts(state)
+{
+    for( auto* param : apvts.processor.getParameters() )
+    {
+        if( auto* rap = dynamic_cast<juce::RangedAudioParameter*>(param) )
+            apvts.addParameterListener(rap->paramID, this);
+    }
+
+    startThread();
+}
+
+CoefficientDesigner::~CoefficientDesigner()
+{
+    for( auto* param : apvts.processor.getParameters() )
+    {
+        if( auto* rap = dynamic_cast<juce::RangedAudioParameter*>(param) )
+            apvts.removeParameterListener(rap->paramID, this);
+    }
+
+    stopThread(1000);
+}
+
+void CoefficientDesigner::prepare(double newSampleRate, CutCoefficientTable::Ptr newTable)
+{
+    {
+        // the table and the sample rate have to change together
+        const juce::ScopedLock sl(designLock);
+        table = std::move(newTable);
+        sampleRate = newSampleRate;
+    }
+
+    designNow();
+}
+
+void CoefficientDesigner::designNow()
+{
+    markAllBandsDirty();
+    needsDesign = false;
+    designDirtyBands();
+}
+
+void CoefficientDesigner::designIfNeeded()
+{
+    if( needsDesign.exchange(false) )
+        designDirtyBands();
+}
+
+void CoefficientDesigner::markAllBandsDirty()
+{
+    for( auto& version : parameterVersions )
+        ++version;
+}
+
+void CoefficientDesigner::designDirtyBands()
+{
+    const juce::ScopedLock sl(designLock);
+
+    auto sr = sampleRate.load();
+    if( sr <= 0 )
+        return;
+
+    bool changed = false;
+
+    for( int band = 0; band < NumChainPositions; ++band )
+    {
+        // read the version before the parameters, so a change that lands
+        // while we're designing bumps it again and gets picked up next time.
+        auto version = parameterVersions[band].load();
+        if( version == designedVersions[band] )
+            continue;
+
+        designedVersions[band] = version;
+
+        switch( band )
+        {
+            case ChainPositions::LowCut:
+                getLowCutSettings(apvts, current.settings);
+                designLowCut(current.lowCut, current.settings, sr, table.get());
+                break;
+            case ChainPositions::Peak:
+                getPeakSettings(apvts, current.settings);
+                designPeak(current, current.settings, sr);
+                break;
+            case ChainPositions::HighCut:
+                getHighCutSettings(apvts, current.settings);
+                designHighCut(current.highCut, current.settings, sr, table.get());
+                break;
+            default:
+                jassertfalse;
+                break;
+        }
+
+        ++current.bandVersions[band];
+        changed = true;
+    }
+
+    if( ! changed )
+        return;
+
+    current.sampleRate = sr;
+    snapshots.getWriteSlot() = current;
+    snapshots.publish();
+}
+
+void CoefficientDesigner::run()
+{
+    while( ! threadShouldExit() )
+    {
+        // polled, not woken: notify() takes a lock, and the parameters change on the audio thread
+        wait(PollIntervalMs);
+        designIfNeeded();
+    }
+}
+
+void CoefficientDesigner::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // this can be called from the audio thread during automation, so only flag it for the designer thread.
+    juce::ignoreUnused(newValue);
+
+    auto band = getBandForParameter(parameterID);
+    if( band < 0 )
+        return;
+
+    ++parameterVersions[band];
+    needsDesign = true;
+}
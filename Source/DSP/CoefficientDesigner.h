@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.h
+    Created: 17 Oct 2026 9:31:12am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterCoefficients.h"
+#include "TripleBuffer.h"
+#include "CutCoefficientTable.h"
+
+FilterCoefficients designFilterCoefficients(const ChainSettings& chainSettings, double sampleRate);
+
+// the cuts come out of the table when there is one that covers the frequency.
+void designLowCut(CutCoefficients& lowCut, const ChainSettings& chainSettings, double sampleRate,
+                  const CutCoefficientTable* table = nullptr);
+void designPeak(FilterCoefficients& coefficients, const ChainSettings& chainSettings, double sampleRate);
+void designHighCut(CutCoefficients& highCut, const ChainSettings& chainSettings, double sampleRate,
+                   const CutCoefficientTable* table = nullptr);
+
+/** returns the ChainPositions band a parameter belongs to, or -1 if it doesn't affect the filters. */
+int getBandForParameter(const juce::String& parameterID);
+
+/**
+ Redesigns the filter coefficients on its own thread whenever a parameter changes
+ and hands finished snapshots to the audio thread through a TripleBuffer.
+ A change only sets an atomic flag, which that thread checks every PollIntervalMs.
+ The audio thread only ever calls pullLatest() / getCoefficients().
+
+ Every band has its own parameter version, so only the bands whose parameters
+ moved get redesigned, and parameters that don't touch the filters cost nothing.
+ */
+struct CoefficientDesigner : private juce::Thread,
+                             private juce::AudioProcessorValueTreeState::Listener
+{
+    CoefficientDesigner(juce::AudioProcessorValueTreeState& apvts);
+    ~CoefficientDesigner() override;
+
+    /** sets the sample rate and publishes a fresh snapshot before returning.
+        the table is optional, it has to be for the same sample rate. */
+    void prepare(double sampleRate, CutCoefficientTable::Ptr table = nullptr);
+
+    /** redesigns every band and publishes on the calling thread. */
+    void designNow();
+
+    /** redesigns the bands that changed since the last design on the calling thread.
+        Used when rendering offline, where the designer thread could lag behind the host. */
+    void designIfNeeded();
+
+    //==============================================================================
+    // audio thread
+    /** swaps in the newest snapshot. returns false if nothing changed since the last call. */
+    bool pullLatest() { return snapshots.acquireLatest(); }
+    const FilterCoefficients& getCoefficients() const { return snapshots.getReadSlot(); }
+private:
+    static constexpr int PollIntervalMs = 5;
+
+    void run() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    void markAllBandsDirty();
+    void designDirtyBands();
+
+    juce::AudioProcessorValueTreeState& apvts;
+
+    TripleBuffer<FilterCoefficients> snapshots;
+    juce::CriticalSection designLock;   // only contended when rendering offline
+
+    std::array<std::atomic<juce::uint32>, NumChainPositions> parameterVersions {};
+    std::atomic<bool> needsDesign { false };
+    std::atomic<double> sampleRate { 0 };
+
+    // only touched while holding designLock
+    CutCoefficientTable::Ptr table;
+    std::array<juce::uint32, NumChainPositions> designedVersions {};
+    FilterCoefficients current;
+};
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    CoefficientSmoother.cpp
+    Created: 17 Oct 2026 1:05:47pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "CoefficientSmoother.h"
+#include "CoefficientDesigner.h"
+
+void CoefficientSmoother::prepare(double sampleRate, CutCoefficientTable::Ptr newTable)
+{
+    table = std::move(newTable);
+
+    lowCutFreq.reset(sampleRate, RampLengthSeconds);
+    highCutFreq.reset(sampleRate, RampLengthSeconds);
+    peakFreq.reset(sampleRate, RampLengthSeconds);
+    peakQuality.reset(sampleRate, RampLengthSeconds);
+    peakGain.reset(sampleRate, RampLengthSeconds);
+
+    current = FilterCoefficients();
+    current.sampleRate = sampleRate;
+    hasBand.fill(false);
+}
+
+bool CoefficientSmoother::glideTo(const FilterCoefficients& target, int band)
+{
+    if( ! hasBand[band] || target.sampleRate != current.sampleRate )
+        return false;
+
+    const auto& settings = current.settings;
+    const auto& targetSettings = target.settings;
+
+    switch( band )
+    {
+        case ChainPositions::LowCut:
+            if( targetSettings.lowCutSlope != settings.lowCutSlope
+             || targetSettings.lowCutBypassed != settings.lowCutBypassed )
+                return false;
+
+            lowCutFreq.setTargetValue(targetSettings.lowCutFreq);
+            return true;
+
+        case ChainPositions::Peak:
+            if( targetSettings.peakBypassed != settings.peakBypassed )
+                return false;
+
+            peakFreq.setTargetValue(targetSettings.peakFreq);
+            peakQuality.setTargetValue(targetSettings.peakQuality);
+            peakGain.setTargetValue(targetSettings.peakGainInDecibels);
+            return true;
+
+        case ChainPositions::HighCut:
+            if( targetSettings.highCutSlope != settings.highCutSlope
+             || targetSettings.highCutBypassed != settings.highCutBypassed )
+                return false;
+
+            highCutFreq.setTargetValue(targetSettings.highCutFreq);
+            return true;
+
+        default:
+            jassertfalse;
+            return false;
+    }
+}
+
+void CoefficientSmoother::jumpTo(const FilterCoefficients& target, int band)
+{
+    auto& settings = current.settings;
+    const auto& targetSettings = target.settings;
+
+    switch( band )
+    {
+        case ChainPositions::LowCut:
+            current.lowCut = target.lowCut;
+            settings.lowCutFreq = targetSettings.lowCutFreq;
+            settings.lowCutSlope = targetSettings.lowCutSlope;
+            settings.lowCutBypassed = targetSettings.lowCutBypassed;
+            lowCutFreq.setCurrentAndTargetValue(targetSettings.lowCutFreq);
+            break;
+
+        case ChainPositions::Peak:
+            current.peak = target.peak;
+            current.peakBypassed = target.peakBypassed;
+            settings.peakFreq = targetSettings.peakFreq;
+            settings.peakQuality = targetSettings.peakQuality;
+            settings.peakGainInDecibels = targetSettings.peakGainInDecibels;
+            settings.peakBypassed = targetSettings.peakBypassed;
+            peakFreq.setCurrentAndTargetValue(targetSettings.peakFreq);
+            peakQuality.setCurrentAndTargetValue(targetSettings.peakQuality);
+            peakGain.setCurrentAndTargetValue(targetSettings.peakGainInDecibels);
+            break;
+
+        case ChainPositions::HighCut:
+            current.highCut = target.highCut;
+            settings.highCutFreq = targetSettings.highCutFreq;
+            settings.highCutSlope = targetSettings.highCutSlope;
+            settings.highCutBypassed = targetSettings.highCutBypassed;
+            highCutFreq.setCurrentAndTargetValue(targetSettings.highCutFreq);
+            break;
+
+        default:
+            jassertfalse;
+            return;
+    }
+
+    current.sampleRate = target.sampleRate;
+    hasBand[band] = true;
+}
+
+bool CoefficientSmoother::isSmoothing() const
+{
+    return lowCutFreq.isSmoothing()
+        || highCutFreq.isSmoothing()
+        || peakFreq.isSmoothing()
+        || peakQuality.isSmoothing()
+        || peakGain.isSmoothing();
+}
+
+int CoefficientSmoother::advance(int numSamples)
+{
+    int changedBands = 0;
+    auto& settings = current.settings;
+    const auto sampleRate = current.sampleRate;
+
+    if( lowCutFreq.isSmoothing() )
+    {
+        settings.lowCutFreq = lowCutFreq.skip(numSamples);
+        designLowCut(current.lowCut, settings, sampleRate, table.get());
+        changedBands |= 1 << ChainPositions::LowCut;
+    }
+
+    if( peakFreq.isSmoothing() || peakQuality.isSmoothing() || peakGain.isSmoothing() )
+    {
+        settings.peakFreq = peakFreq.skip(numSamples);
+        settings.peakQuality = peakQuality.skip(numSamples);
+        settings.peakGainInDecibels = peakGain.skip(numSamples);
+        designPeak(current, settings, sampleRate);
+        changedBands |= 1 << ChainPositions::Peak;
+    }
+
+    if( highCutFreq.isSmoothing() )
+    {
+        settings.highCutFreq = highCutFreq.skip(numSamples);
+        designHighCut(current.highCut, settings, sampleRate, table.get());
+        changedBands |= 1 << ChainPositions::HighCut;
+    }
+
+    return changedBands;
+}
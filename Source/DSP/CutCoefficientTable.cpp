@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    CutCoefficientTable.cpp
+    Created: 17 Oct 2026 3:02:15pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "CutCoefficientTable.h"
+#include "CoefficientDesigner.h"
+#include "ParameterRanges.h"
+
+namespace
+{
+constexpr int MinTableFrequency = static_cast<int>(MIN_FREQUENCY);
+constexpr int MaxTableFrequency = static_cast<int>(MAX_FREQUENCY);
+constexpr int NumTableFrequencies = MaxTableFrequency - MinTableFrequency + 1;
+
+BiquadCoefficients interpolate(const BiquadCoefficients& a, const BiquadCoefficients& b, float amount)
+{
+    return { a.b0 + (b.b0 - a.b0) * amount,
+             a.b1 + (b.b1 - a.b1) * amount,
+             a.b2 + (b.b2 - a.b2) * amount,
+             a.a1 + (b.a1 - a.a1) * amount,
+             a.a2 + (b.a2 - a.a2) * amount };
+}
+}
+
+CutCoefficientTable::CutCoefficientTable(double rate) :
+sampleRate(rate)
+{
+    for( int slope = 0; slope < MaxCutSections; ++slope )
+    {
+        const auto numSections = slope + 1;
+        lowCut[slope].resize(static_cast<size_t>(NumTableFrequencies * numSections));
+        highCut[slope].resize(static_cast<size_t>(NumTableFrequencies * numSections));
+
+        ChainSettings settings;
+        settings.lowCutSlope = static_cast<Slope>(slope);
+        settings.highCutSlope = static_cast<Slope>(slope);
+
+        CutCoefficients cut;
+
+        for( int i = 0; i < NumTableFrequencies; ++i )
+        {
+            settings.lowCutFreq = static_cast<float>(MinTableFrequency + i);
+            settings.highCutFreq = settings.lowCutFreq;
+
+            designLowCut(cut, settings, sampleRate);
+            std::copy_n(cut.sections.begin(), numSections, lowCut[slope].begin() + i * numSections);
+
+            designHighCut(cut, settings, sampleRate);
+            std::copy_n(cut.sections.begin(), numSections, highCut[slope].begin() + i * numSections);
+        }
+    }
+}
+
+bool CutCoefficientTable::lookupLowCut(CutCoefficients& cut, float frequency, Slope slope) const
+{
+    return lookup(lowCut, cut, frequency, slope);
+}
+
+bool CutCoefficientTable::lookupHighCut(CutCoefficients& cut, float frequency, Slope slope) const
+{
+    return lookup(highCut, cut, frequency, slope);
+}
+
+bool CutCoefficientTable::lookup(const Bank& bank, CutCoefficients& cut, float frequency, Slope slope) const
+{
+    auto position = frequency - static_cast<float>(MinTableFrequency);
+
+    // written this way round so NaN fails too
+    if( ! (position >= 0.f && position <= static_cast<float>(NumTableFrequencies - 1)) )
+        return false;
+
+    const auto index = static_cast<int>(position);
+    const auto amount = position - static_cast<float>(index);
+    const auto numSections = static_cast<int>(slope) + 1;
+    const auto* entry = bank[slope].data() + index * numSections;
+
+    if( amount == 0.f )
+    {
+        std::copy_n(entry, numSections, cut.sections.begin());
+    }
+    else
+    {
+        const auto* next = entry + numSections;
+        for( int i = 0; i < numSections; ++i )
+            cut.sections[i] = interpolate(entry[i], next[i], amount);
+    }
+
+    return true;
+}
+
+size_t CutCoefficientTable::getMemoryUsage()
+{
+    // 1 + 2 + 3 + 4 sections per frequency, for both the low cut and the high cut
+    constexpr size_t sectionsPerFrequency = MaxCutSections * (MaxCutSections + 1) / 2;
+
+    return sizeof(CutCoefficientTable)
+         + 2 * NumTableFrequencies * sectionsPerFrequency * sizeof(BiquadCoefficients);
+}
+
+//==============================================================================
+CutCoefficientTable::Ptr CutCoefficientTableCache::getTable(double sampleRate)
+{
+    const juce::ScopedLock sl(lock);
+
+    if( auto table = tables[sampleRate].lock() )
+        return table;
+
+    // forget the sample rates nobody uses anymore
+    for( auto it = tables.begin(); it != tables.end(); )
+        it = it->second.expired() ? tables.erase(it) : std::next(it);
+
+    auto total = getMemoryUsageLocked() + CutCoefficientTable::getMemoryUsage();
+
+    // the caller designs the cuts directly instead
+    if( total > MaxMemoryUsage )
+        return nullptr;
+
+    auto table = std::make_shared<const CutCoefficientTable>(sampleRate);
+    tables[sampleRate] = table;
+    return table;
+}
+
+size_t CutCoefficientTableCache::getMemoryUsage() const
+{
+    const juce::ScopedLock sl(lock);
+    return getMemoryUsageLocked();
+}
+
+size_t CutCoefficientTableCache::getMemoryUsageLocked() const
+{
+    size_t numTables = 0;
+
+    for( const auto& entry : tables )
+        if( ! entry.second.expired() )
+            ++numTables;
+
+    return numTables * CutCoefficientTable::getMemoryUsage();
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    CutCoefficientTable.h
+    Created: 17 Oct 2026 3:02:15pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include "FilterCoefficients.h"
+
+/**
+ Every low cut and high cut design for one sample rate, one entry per Hz from
+ MIN_FREQUENCY to MAX_FREQUENCY for every slope. The cut frequencies move in 1 Hz
+ steps, so a parameter change is a copy out of the table instead of a design.
+
+ Frequencies between two entries, which only happen while smoothing, are
+ interpolated linearly. The a1/a2 pairs of stable biquads form a triangle,
+ so the interpolated sections stay stable.
+
+ Tables are immutable once built and get shared through a CutCoefficientTableCache.
+ */
+struct CutCoefficientTable
+{
+    using Ptr = std::shared_ptr<const CutCoefficientTable>;
+
+    explicit CutCoefficientTable(double sampleRate);
+
+    /** both return false if the frequency isn't covered, the caller has to design it then. */
+    bool lookupLowCut(CutCoefficients& lowCut, float frequency, Slope slope) const;
+    bool lookupHighCut(CutCoefficients& highCut, float frequency, Slope slope) const;
+
+    double getSampleRate() const { return sampleRate; }
+
+    /** bytes per table, they're all the same size. */
+    static size_t getMemoryUsage();
+private:
+    // per slope, numFrequencies entries of slope + 1 sections each
+    using Bank = std::array<std::vector<BiquadCoefficients>, MaxCutSections>;
+
+    bool lookup(const Bank& bank, CutCoefficients& cut, float frequency, Slope slope) const;
+
+    double sampleRate;
+    Bank lowCut, highCut;
+};
+
+/**
+ Hands out one CutCoefficientTable per sample rate to every instance in the process.
+ Hold it in a juce::SharedResourcePointer. Tables live as long as somebody uses them,
+ and no table gets built if it would take the total over MaxMemoryUsage.
+ */
+class CutCoefficientTableCache
+{
+public:
+    // a table is about 8 MB, so a few sample rates at once
+    static constexpr size_t MaxMemoryUsage = 32 * 1024 * 1024;
+
+    /** builds the table if nobody holds one for this sample rate yet. might return nullptr. */
+    CutCoefficientTable::Ptr getTable(double sampleRate);
+
+    /** bytes held by the tables that are still in use. */
+    size_t getMemoryUsage() const;
+private:
+    size_t getMemoryUsageLocked() const;
+
+    juce::CriticalSection lock;
+    std::map<double, std::weak_ptr<const CutCoefficientTable>> tables;
+};
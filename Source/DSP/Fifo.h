@@ -11,8 +11,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
-template<typename T>
+template<typename T, int Capacity = 30>
 struct Fifo
 {
     void prepare(int numChannels, int numSamples)
@@ -41,24 +42,58 @@ struct Fifo
         }
     }
     
-    bool push(const T& t)
+    /**
+     the next free slot, to be filled in place and handed over with commitWrite().
+     returns nullptr, and counts a dropped push, if the reader fell behind and there is none.
+     */
+    T* acquireWrite()
     {
-        auto write = fifo.write(1);
-        if( write.blockSize1 > 0 )
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+        if( size1 == 0 )
         {
-            buffers[write.startIndex1] = t;
+            droppedPushes.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        
+        return &buffers[start1];
+    }
+    
+    void commitWrite() { fifo.finishedWrite(1); }
+    
+    /** the oldest filled slot, to be read in place and given back with releaseRead(). nullptr if there is none. */
+    T* acquireRead()
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+        return size1 > 0 ? &buffers[start1] : nullptr;
+    }
+    
+    void releaseRead() { fifo.finishedRead(1); }
+    
+    /**
+     swaps t into the next free slot, so nothing gets copied or allocated.
+     t gets back whatever storage that slot had.
+     */
+    bool push(T& t)
+    {
+        if( auto* slot = acquireWrite() )
+        {
+            std::swap(*slot, t);
+            commitWrite();
             return true;
         }
         
         return false;
     }
     
+    /** swaps the oldest slot out into t, the slot keeps t's old storage for the next push. */
     bool pull(T& t)
     {
-        auto read = fifo.read(1);
-        if( read.blockSize1 > 0 )
+        if( auto* slot = acquireRead() )
         {
-            t = buffers[read.startIndex1];
+            std::swap(*slot, t);
+            releaseRead();
             return true;
         }
         
@@ -69,8 +104,11 @@ struct Fifo
     {
         return fifo.getNumReady();
     }
+    
+    /** how many pushes found the fifo full since it was created. */
+    int getNumDroppedPushes() const { return droppedPushes.load(std::memory_order_relaxed); }
 private:
-    static constexpr int Capacity = 30;
     std::array<T, Capacity> buffers;
     juce::AbstractFifo fifo {Capacity};
+    std::atomic<int> droppedPushes { 0 };
 };
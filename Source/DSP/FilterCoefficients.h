@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    FilterCoefficients.h
+    Created: 17 Oct 2026 9:14:31am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include "ChainSettings.h"
+
+/**
+ Normalised (a0 == 1) second order section, in the same order as the raw
+ coefficient array of a biquad juce::dsp::IIR::Coefficients<float>.
+ */
+struct BiquadCoefficients
+{
+    float b0 { 1.f }, b1 { 0.f }, b2 { 0.f }, a1 { 0.f }, a2 { 0.f };
+};
+
+// 1 section = 12db, so 4 sections for 48db
+static constexpr int MaxCutSections = 4;
+
+struct CutCoefficients
+{
+    std::array<BiquadCoefficients, MaxCutSections> sections;
+    Slope slope { Slope::Slope_12 };
+    bool bypassed { false };
+
+    int getNumSections() const { return static_cast<int>(slope) + 1; }
+};
+
+/**
+ An immutable, allocation free snapshot of every coefficient the chain needs.
+ These get designed away from the audio thread and handed over as a whole.
+ */
+struct FilterCoefficients
+{
+    CutCoefficients lowCut, highCut;
+    BiquadCoefficients peak;
+    bool peakBypassed { false };
+    double sampleRate { 0 };
+    
+    // what these were designed from, so the audio thread can glide towards it.
+    ChainSettings settings;
+    
+    // bumped every time a band is redesigned, indexed by ChainPositions.
+    // lets the audio thread skip bands that didn't change.
+    std::array<juce::uint32, NumChainPositions> bandVersions {};
+};
@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.cpp
+    Created: 17 Oct 2026 10:52:37pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+#include "CoefficientDesigner.h"
+
+namespace
+{
+using SIMDType = juce::dsp::SIMDRegister<float>;
+
+/** SIMDRegister has no division. */
+SIMDType divide(SIMDType a, SIMDType b) noexcept
+{
+#if JUCE_USE_AVX_INTRINSICS
+    return SIMDType::fromNative(_mm256_div_ps(a.value, b.value));
+#elif JUCE_USE_SSE_INTRINSICS
+    return SIMDType::fromNative(_mm_div_ps(a.value, b.value));
+#elif JUCE_USE_ARM_NEON && defined(__aarch64__)
+    return SIMDType::fromNative(vdivq_f32(a.value, b.value));
+#else
+    for( size_t i = 0; i < SIMDType::SIMDNumElements; ++i )
+        a.set(i, a.get(i) / b.get(i));
+    return a;
+#endif
+}
+
+SIMDType abs(SIMDType x) noexcept
+{
+    return SIMDType::max(x, SIMDType::expand(0.f) - x);
+}
+
+void resize(FrequencyResponse& response, int numFrequencies)
+{
+    const auto size = static_cast<size_t>(numFrequencies);
+    response.magnitudeInDecibels.resize(size);
+    response.phaseInRadians.resize(size);
+    response.groupDelayInSeconds.resize(size);
+}
+}
+
+void FrequencyResponseEngine::setFrequencies(const float* newFrequencies, int numFrequencies, double newSampleRate)
+{
+    jassert(newSampleRate > 0);
+
+    sampleRate = newSampleRate;
+    frequencies.assign(newFrequencies, newFrequencies + numFrequencies);
+    registers.resize((frequencies.size() + NumLanes - 1) / NumLanes);
+
+    // the lanes past the last frequency are at w = 0 and never get read back
+    for( size_t r = 0; r < registers.size(); ++r )
+    {
+        auto& reg = registers[r];
+        reg.sinW = reg.oneMinusCosW = SIMDType::expand(0.f);
+
+        for( size_t lane = 0; lane < NumLanes && r * NumLanes + lane < frequencies.size(); ++lane )
+        {
+            const auto w = juce::MathConstants<double>::twoPi * frequencies[r * NumLanes + lane] / sampleRate;
+
+            // 1 - cos w = 2 sin^2 (w / 2), which doesn't cancel at low frequencies
+            const auto sinHalfW = std::sin(w * 0.5);
+
+            reg.sinW.set(lane, static_cast<float>(std::sin(w)));
+            reg.oneMinusCosW.set(lane, static_cast<float>(2.0 * sinHalfW * sinHalfW));
+        }
+    }
+}
+
+void FrequencyResponseEngine::setFrequencies(const std::vector<float>& newFrequencies, double newSampleRate)
+{
+    setFrequencies(newFrequencies.data(), static_cast<int>(newFrequencies.size()), newSampleRate);
+}
+
+void FrequencyResponseEngine::setLogFrequencies(int numFrequencies, float lowest, float highest, double newSampleRate)
+{
+    std::vector<float> logFrequencies(static_cast<size_t>(juce::jmax(0, numFrequencies)));
+
+    for( size_t i = 0; i < logFrequencies.size(); ++i )
+    {
+        logFrequencies[i] = static_cast<float>(juce::mapToLog10(double(i) / double(numFrequencies),
+                                                                double(lowest),
+                                                                double(highest)));
+    }
+
+    setFrequencies(logFrequencies, newSampleRate);
+}
+
+//==============================================================================
+void FrequencyResponseEngine::process(const FilterCoefficients& coefficients, FrequencyResponse& response)
+{
+    jassert(coefficients.sampleRate == sampleRate);
+
+    numSections = 0;
+    addCut(coefficients.lowCut);
+    if( ! coefficients.peakBypassed )
+        addSection(coefficients.peak);
+    addCut(coefficients.highCut);
+
+    evaluate(response);
+}
+
+void FrequencyResponseEngine::process(const FilterCoefficients& coefficients, ChainPositions band, FrequencyResponse& response)
+{
+    jassert(coefficients.sampleRate == sampleRate);
+
+    numSections = 0;
+
+    switch( band )
+    {
+        case ChainPositions::LowCut:
+            addCut(coefficients.lowCut);
+            break;
+        case ChainPositions::Peak:
+            if( ! coefficients.peakBypassed )
+                addSection(coefficients.peak);
+            break;
+        case ChainPositions::HighCut:
+            addCut(coefficients.highCut);
+            break;
+        default:
+            jassertfalse;
+            break;
+    }
+
+    evaluate(response);
+}
+
+void FrequencyResponseEngine::process(const ChainSettings& chainSettings, FrequencyResponse& response)
+{
+    process(designFilterCoefficients(chainSettings, sampleRate), response);
+}
+
+void FrequencyResponseEngine::addSection(const BiquadCoefficients& c)
+{
+    jassert(numSections < MaxSections);
+
+    // the sums in double, they're where the cuts' zeros and poles near z = 1 cancel
+    auto expand = [](double value) { return SIMDType::expand(static_cast<float>(value)); };
+    const double b0 = c.b0, b1 = c.b1, b2 = c.b2, a1 = c.a1, a2 = c.a2;
+
+    auto& section = sections[static_cast<size_t>(numSections++)];
+    section.b2 = expand(b2);
+    section.sumB = expand(b0 + b1 + b2);
+    section.slopeB = expand(b1 + 2.0 * b2);
+    section.quadB = expand(b1 + 4.0 * b2);
+    section.octB = expand(b1 + 8.0 * b2);
+    section.a2 = expand(a2);
+    section.sumA = expand(1.0 + a1 + a2);
+    section.slopeA = expand(a1 + 2.0 * a2);
+    section.quadA = expand(a1 + 4.0 * a2);
+    section.octA = expand(a1 + 8.0 * a2);
+}
+
+void FrequencyResponseEngine::addCut(const CutCoefficients& cut)
+{
+    if( cut.bypassed )
+        return;
+
+    for( int i = 0; i < cut.getNumSections(); ++i )
+        addSection(cut.sections[static_cast<size_t>(i)]);
+}
+
+void FrequencyResponseEngine::evaluate(FrequencyResponse& response)
+{
+    resize(response, getNumFrequencies());
+
+    const auto one = SIMDType::expand(1.f);
+    const auto two = SIMDType::expand(2.f);
+    const auto four = SIMDType::expand(4.f);
+
+    // keeps zeros on the unit circle from dividing by 0, their delay comes out as 0
+    const auto tiny = SIMDType::expand(std::numeric_limits<float>::min());
+
+    const auto minGainSquared = juce::Decibels::decibelsToGain(2.f * MinusInfinityDb, -1000.f);
+    const auto secondsPerSample = static_cast<float>(1.0 / sampleRate);
+
+    for( size_t r = 0; r < registers.size(); ++r )
+    {
+        const auto& reg = registers[r];
+
+        auto magnitudeSquared = one;
+        auto groupDelay = SIMDType::expand(0.f);
+
+        // the product of every section's N conj(D), rescaled as it goes
+        // so it neither underflows in the stop bands nor overflows. only its angle matters.
+        auto phaseReal = one;
+        auto phaseImag = SIMDType::expand(0.f);
+
+        for( int s = 0; s < numSections; ++s )
+        {
+            const auto& section = sections[static_cast<size_t>(s)];
+
+            // the imaginary parts are negated, they only ever get multiplied with each other
+            // or show up in the phase, where the signs are accounted for.
+            const auto v = reg.oneMinusCosW;
+            const auto b2v = section.b2 * v;
+            const auto nReal = section.sumB - v * (section.quadB - two * b2v);
+            const auto nImag = reg.sinW * (section.slopeB - two * b2v);
+            const auto nSlopeReal = section.slopeB - v * (section.octB - four * b2v);
+            const auto nSlopeImag = reg.sinW * (section.quadB - four * b2v);
+
+            const auto a2v = section.a2 * v;
+            const auto dReal = section.sumA - v * (section.quadA - two * a2v);
+            const auto dImag = reg.sinW * (section.slopeA - two * a2v);
+            const auto dSlopeReal = section.slopeA - v * (section.octA - four * a2v);
+            const auto dSlopeImag = reg.sinW * (section.quadA - four * a2v);
+
+            const auto nn = SIMDType::max(nReal * nReal + nImag * nImag, tiny);
+            const auto dd = SIMDType::max(dReal * dReal + dImag * dImag, tiny);
+
+            magnitudeSquared *= divide(nn, dd);
+
+            // group delay of a polynomial P in z^-1 is Re(P' / P), with P' = sum of k p_k z^-k
+            groupDelay += divide(nSlopeReal * nReal + nSlopeImag * nImag, nn)
+                        - divide(dSlopeReal * dReal + dSlopeImag * dImag, dd);
+
+            // times N conj(D), with the negated imaginary parts
+            const auto qReal = nReal * dReal + nImag * dImag;
+            const auto qImag = nReal * dImag - nImag * dReal;
+            const auto real = phaseReal * qReal - phaseImag * qImag;
+            const auto imag = phaseReal * qImag + phaseImag * qReal;
+
+            const auto scale = divide(one, SIMDType::max(SIMDType::max(abs(real), abs(imag)), tiny));
+            phaseReal = real * scale;
+            phaseImag = imag * scale;
+        }
+
+        // the logs and angles are once per frequency, not per section, so they stay scalar
+        const auto first = r * NumLanes;
+        const auto numLanes = juce::jmin(NumLanes, frequencies.size() - first);
+
+        for( size_t lane = 0; lane < numLanes; ++lane )
+        {
+            const auto i = first + lane;
+            response.magnitudeInDecibels[i] = 10.f * std::log10(juce::jmax(magnitudeSquared.get(lane), minGainSquared));
+            response.phaseInRadians[i] = std::atan2(phaseImag.get(lane), phaseReal.get(lane));
+            response.groupDelayInSeconds[i] = groupDelay.get(lane) * secondsPerSample;
+        }
+    }
+}
+
+//==============================================================================
+void computeFrequencyResponseReference(const FilterCoefficients& coefficients,
+                                       const float* frequencies,
+                                       int numFrequencies,
+                                       FrequencyResponse& response)
+{
+    using Complex = std::complex<double>;
+
+    std::vector<BiquadCoefficients> sections;
+
+    auto addCut = [&sections](const CutCoefficients& cut)
+    {
+        if( ! cut.bypassed )
+            sections.insert(sections.end(), cut.sections.begin(), cut.sections.begin() + cut.getNumSections());
+    };
+
+    addCut(coefficients.lowCut);
+    if( ! coefficients.peakBypassed )
+        sections.push_back(coefficients.peak);
+    addCut(coefficients.highCut);
+
+    resize(response, numFrequencies);
+
+    for( int i = 0; i < numFrequencies; ++i )
+    {
+        const auto w = juce::MathConstants<double>::twoPi * frequencies[i] / coefficients.sampleRate;
+        const auto z1 = std::polar(1.0, -w);
+        const auto z2 = z1 * z1;
+
+        Complex h { 1.0, 0.0 };
+        double groupDelay = 0;
+
+        for( const auto& c : sections )
+        {
+            const auto n = double(c.b0) + double(c.b1) * z1 + double(c.b2) * z2;
+            const auto d = 1.0 + double(c.a1) * z1 + double(c.a2) * z2;
+            const auto nSlope = double(c.b1) * z1 + 2.0 * double(c.b2) * z2;
+            const auto dSlope = double(c.a1) * z1 + 2.0 * double(c.a2) * z2;
+
+            h *= n / d;
+            groupDelay += (nSlope / n).real() - (dSlope / d).real();
+        }
+
+        response.magnitudeInDecibels[static_cast<size_t>(i)] = juce::Decibels::gainToDecibels(static_cast<float>(std::abs(h)),
+                                                                                             FrequencyResponseEngine::MinusInfinityDb);
+        response.phaseInRadians[static_cast<size_t>(i)] = static_cast<float>(std::arg(h));
+        response.groupDelayInSeconds[static_cast<size_t>(i)] = static_cast<float>(groupDelay / coefficients.sampleRate);
+    }
+}
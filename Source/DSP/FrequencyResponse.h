@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.h
+    Created: 17 Oct 2026 10:52:37pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterCoefficients.h"
+
+/** the response of a filter chain, one value per frequency. */
+struct FrequencyResponse
+{
+    // floored at FrequencyResponseEngine::MinusInfinityDb
+    std::vector<float> magnitudeInDecibels;
+
+    // wrapped to -pi..pi
+    std::vector<float> phaseInRadians;
+
+    // minus the derivative of the phase, so not wrapped
+    std::vector<float> groupDelayInSeconds;
+
+    int size() const { return static_cast<int>(magnitudeInDecibels.size()); }
+};
+
+/**
+ Evaluates a whole filter chain at a set of frequencies in one go, for the response curve,
+ the offline tools and anything else that sweeps settings.
+
+ The frequencies are kept as a structure of arrays, one SIMD register of frequencies at a time,
+ with sin w and 1 - cos w worked out once in setFrequencies(). Every section of the chain
+ then costs a few multiply-adds per register instead of a complex polynomial per biquad
+ per frequency like IIR::Coefficients::getMagnitudeForFrequency(), and it all stays
+ accurate in float, even for the cuts' zeros and poles around z = 1.
+
+ setFrequencies() allocates, process() doesn't once the response has the right size.
+ */
+struct FrequencyResponseEngine
+{
+    // the same as juce::Decibels::gainToDecibels()
+    static constexpr float MinusInfinityDb = -100.f;
+
+    void setFrequencies(const float* frequencies, int numFrequencies, double sampleRate);
+    void setFrequencies(const std::vector<float>& frequencies, double sampleRate);
+
+    /** numFrequencies log spaced frequencies from lowest on, the way the response curve draws them. */
+    void setLogFrequencies(int numFrequencies, float lowest, float highest, double sampleRate);
+
+    int getNumFrequencies() const { return static_cast<int>(frequencies.size()); }
+    float getFrequency(int index) const { return frequencies[static_cast<size_t>(index)]; }
+    double getSampleRate() const { return sampleRate; }
+
+    /** the whole chain, leaving out bypassed bands. the coefficients have to be for getSampleRate(). */
+    void process(const FilterCoefficients& coefficients, FrequencyResponse& response);
+
+    /** one band on its own, flat if it's bypassed.
+        the bands' group delays add up to the whole chain's, the phases do modulo 2 pi, and so do the
+        decibels, except where a band is floored at MinusInfinityDb and the sum comes out higher. */
+    void process(const FilterCoefficients& coefficients, ChainPositions band, FrequencyResponse& response);
+
+    /** designs the coefficients at getSampleRate() first, the same way the CoefficientDesigner does. */
+    void process(const ChainSettings& chainSettings, FrequencyResponse& response);
+
+    /** a juce::dsp::IIR chain laid out like MonoChain, the way the benchmarks' updateResponseChain() sets one up. */
+    template<typename ChainType>
+    void process(const ChainType& chain, FrequencyResponse& response)
+    {
+        numSections = 0;
+
+        if( ! chain.template isBypassed<ChainPositions::LowCut>() )
+            addCutChain(chain.template get<ChainPositions::LowCut>());
+        if( ! chain.template isBypassed<ChainPositions::Peak>() )
+            addFilter(chain.template get<ChainPositions::Peak>());
+        if( ! chain.template isBypassed<ChainPositions::HighCut>() )
+            addCutChain(chain.template get<ChainPositions::HighCut>());
+
+        evaluate(response);
+    }
+
+private:
+    using SIMDType = juce::dsp::SIMDRegister<float>;
+    static constexpr size_t NumLanes = SIMDType::SIMDNumElements;
+
+    // lowcut 4 + peak 1 + highcut 4
+    static constexpr int MaxSections = 2 * MaxCutSections + 1;
+
+    /** one register of frequencies, w in radians per sample. */
+    struct Frequencies
+    {
+        SIMDType sinW, oneMinusCosW;
+    };
+
+    /**
+     A section's coefficients broadcast to every lane. With z = e^jw, s = sin w and v = 1 - cos w,
+     the numerator b0 + b1 z^-1 + b2 z^-2 is
+     N = sumB - v (quadB - 2 b2 v) - j s (slopeB - 2 b2 v),
+     and the sum of k b_k z^-k its group delay needs is
+     N' = slopeB - v (octB - 4 b2 v) - j s (quadB - 4 b2 v),
+     with sumB = b0 + b1 + b2, slopeB = b1 + 2 b2, quadB = b1 + 4 b2 and octB = b1 + 8 b2.
+     The denominator is the same with a0 = 1, a1, a2. Near z = 1, where the cuts' zeros sit
+     and their poles get close, nothing big cancels, only the sums that get worked out in double.
+     */
+    struct Section
+    {
+        SIMDType b2, sumB, slopeB, quadB, octB;
+        SIMDType a2, sumA, slopeA, quadA, octA;
+    };
+
+    void addSection(const BiquadCoefficients& coefficients);
+    void addCut(const CutCoefficients& cut);
+
+    template<typename Filter>
+    void addFilter(const Filter& filter)
+    {
+        // normalised biquads store b0, b1, b2, a1, a2, the same as BiquadCoefficients
+        jassert(filter.coefficients->coefficients.size() == 5);
+        auto* raw = filter.coefficients->getRawCoefficients();
+        addSection({ raw[0], raw[1], raw[2], raw[3], raw[4] });
+    }
+
+    template<typename CutChain>
+    void addCutChain(const CutChain& cut)
+    {
+        if( ! cut.template isBypassed<0>() )
+            addFilter(cut.template get<0>());
+        if( ! cut.template isBypassed<1>() )
+            addFilter(cut.template get<1>());
+        if( ! cut.template isBypassed<2>() )
+            addFilter(cut.template get<2>());
+        if( ! cut.template isBypassed<3>() )
+            addFilter(cut.template get<3>());
+    }
+
+    /** runs the sections added since numSections was reset over every frequency. */
+    void evaluate(FrequencyResponse& response);
+
+    std::vector<float> frequencies;
+    std::vector<Frequencies> registers;
+    double sampleRate { 0 };
+
+    std::array<Section, MaxSections> sections;
+    int numSections { 0 };
+};
+
+/**
+ The same response from std::complex<double> evaluations of every section, one frequency at a time.
+ Kept to check FrequencyResponseEngine against, and for anything where speed doesn't matter.
+ */
+void computeFrequencyResponseReference(const FilterCoefficients& coefficients,
+                                       const float* frequencies,
+                                       int numFrequencies,
+                                       FrequencyResponse& response);
@@ -0,0 +1,18 @@
+/*
+  ==============================================================================
+
+    ParameterRanges.h
+    Created: 18 Oct 2026 9:12:44am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// the ranges the band parameters cover, which the cut tables and the editor's scales follow
+#define MIN_FREQUENCY 20.f
+#define MAX_FREQUENCY 20000.f
+
+#define MIN_GAIN -24.f
+#define MAX_GAIN 24.f
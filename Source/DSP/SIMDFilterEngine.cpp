@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+    SIMDFilterEngine.cpp
+    Created: 17 Oct 2026 10:42:19am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "SIMDFilterEngine.h"
+#include "CoefficientDesigner.h"
+
+//==============================================================================
+void SIMDFilterEngine::Section::setCoefficients(const BiquadCoefficients& coefficients) noexcept
+{
+    b0 = SIMDType::expand(coefficients.b0);
+    b1 = SIMDType::expand(coefficients.b1);
+    b2 = SIMDType::expand(coefficients.b2);
+    a1 = SIMDType::expand(coefficients.a1);
+    a2 = SIMDType::expand(coefficients.a2);
+
+    db0 = db1 = db2 = da1 = da2 = SIMDType::expand(0.f);
+    target = coefficients;
+    ramping = false;
+}
+
+void SIMDFilterEngine::Section::rampTo(const BiquadCoefficients& coefficients, size_t numSamples) noexcept
+{
+    jassert(numSamples > 0);
+    auto scale = 1.f / static_cast<float>(numSamples);
+
+    // the ramp starts from wherever the last one got to
+    db0 = SIMDType::expand((coefficients.b0 - target.b0) * scale);
+    db1 = SIMDType::expand((coefficients.b1 - target.b1) * scale);
+    db2 = SIMDType::expand((coefficients.b2 - target.b2) * scale);
+    da1 = SIMDType::expand((coefficients.a1 - target.a1) * scale);
+    da2 = SIMDType::expand((coefficients.a2 - target.a2) * scale);
+
+    target = coefficients;
+    ramping = true;
+}
+
+void SIMDFilterEngine::Section::advanceRamp(size_t numSamples) noexcept
+{
+    if( ! ramping )
+        return;
+
+    auto n = SIMDType::expand(static_cast<float>(numSamples));
+    b0 += db0 * n;
+    b1 += db1 * n;
+    b2 += db2 * n;
+    a1 += da1 * n;
+    a2 += da2 * n;
+}
+
+void SIMDFilterEngine::Section::finishRamp() noexcept
+{
+    // land exactly on the target instead of whatever the increments summed up to
+    if( ramping )
+        setCoefficients(target);
+}
+
+void SIMDFilterEngine::Cut::setCoefficients(const CutCoefficients& coefficients) noexcept
+{
+    numSections = coefficients.getNumSections();
+    bypassed = coefficients.bypassed;
+
+    for( int i = 0; i < numSections; ++i )
+        sections[i].setCoefficients(coefficients.sections[i]);
+}
+
+//==============================================================================
+template<int NumSections, bool Ramping>
+void SIMDFilterEngine::processCascade(const Section* const* sections,
+                                      State* const* states,
+                                      SIMDType* samples,
+                                      size_t numSamples) noexcept
+{
+    // transposed direct form II, same as juce::dsp::IIR::Filter.
+    // NumSections is a compile time constant, so the inner loop is fully unrolled
+    // and the coefficients and state live in registers (or at worst on the stack).
+    std::array<SIMDType, NumSections> b0, b1, b2, a1, a2, s1, s2;
+    std::array<SIMDType, Ramping ? NumSections : 0> db0, db1, db2, da1, da2;
+
+    for( int k = 0; k < NumSections; ++k )
+    {
+        if constexpr( Ramping )
+        {
+            db0[k] = sections[k]->db0;
+            db1[k] = sections[k]->db1;
+            db2[k] = sections[k]->db2;
+            da1[k] = sections[k]->da1;
+            da2[k] = sections[k]->da2;
+        }
+
+        b0[k] = sections[k]->b0;
+        b1[k] = sections[k]->b1;
+        b2[k] = sections[k]->b2;
+        a1[k] = sections[k]->a1;
+        a2[k] = sections[k]->a2;
+        s1[k] = states[k]->s1;
+        s2[k] = states[k]->s2;
+    }
+
+    for( size_t i = 0; i < numSamples; ++i )
+    {
+        auto x = samples[i];
+
+        for( int k = 0; k < NumSections; ++k )
+        {
+            auto y = x * b0[k] + s1[k];
+            s1[k] = x * b1[k] - y * a1[k] + s2[k];
+            s2[k] = x * b2[k] - y * a2[k];
+            x = y;
+
+            if constexpr( Ramping )
+            {
+                b0[k] += db0[k];
+                b1[k] += db1[k];
+                b2[k] += db2[k];
+                a1[k] += da1[k];
+                a2[k] += da2[k];
+            }
+        }
+
+        samples[i] = x;
+    }
+
+    // only the state is written back. every lane group starts the ramp from the same
+    // coefficients, advanceRamp() moves the sections along once all groups are done.
+    for( int k = 0; k < NumSections; ++k )
+    {
+        states[k]->s1 = s1[k];
+        states[k]->s2 = s2[k];
+    }
+}
+
+SIMDFilterEngine::CascadeFunction SIMDFilterEngine::getCascadeFunction(int numSections, bool ramping) noexcept
+{
+    static constexpr std::array<CascadeFunction, MaxActiveSections + 1> cascades
+    {
+        &processCascade<0, false>, &processCascade<1, false>, &processCascade<2, false>,
+        &processCascade<3, false>, &processCascade<4, false>, &processCascade<5, false>,
+        &processCascade<6, false>, &processCascade<7, false>, &processCascade<8, false>,
+        &processCascade<9, false>
+    };
+
+    static constexpr std::array<CascadeFunction, MaxActiveSections + 1> rampingCascades
+    {
+        &processCascade<0, true>, &processCascade<1, true>, &processCascade<2, true>,
+        &processCascade<3, true>, &processCascade<4, true>, &processCascade<5, true>,
+        &processCascade<6, true>, &processCascade<7, true>, &processCascade<8, true>,
+        &processCascade<9, true>
+    };
+
+    jassert(0 <= numSections && numSections <= MaxActiveSections);
+    return ramping ? rampingCascades[static_cast<size_t>(numSections)]
+                   : cascades[static_cast<size_t>(numSections)];
+}
+
+void SIMDFilterEngine::updateCascade() noexcept
+{
+    numActiveSections = 0;
+
+    auto addSection = [this](const Section& section, int stateIndex)
+    {
+        activeSections[numActiveSections] = &section;
+
+        for( size_t group = 0; group < MaxLaneGroups; ++group )
+            activeStates[group][numActiveSections] = &states[group][stateIndex];
+
+        ++numActiveSections;
+    };
+
+    auto addCut = [&addSection](const Cut& cut, int firstStateIndex)
+    {
+        if( cut.bypassed )
+            return;
+
+        for( int i = 0; i < cut.numSections; ++i )
+            addSection(cut.sections[i], firstStateIndex + i);
+    };
+
+    addCut(lowCut, LowCutStateIndex);
+
+    if( ! peakBypassed )
+        addSection(peak, PeakStateIndex);
+
+    addCut(highCut, HighCutStateIndex);
+
+    cascade = getCascadeFunction(numActiveSections, false);
+    rampingCascade = getCascadeFunction(numActiveSections, true);
+}
+
+//==============================================================================
+template<typename Fn>
+void SIMDFilterEngine::forEachSection(Fn&& fn)
+{
+    for( auto& section : lowCut.sections )
+        fn(section);
+
+    fn(peak);
+
+    for( auto& section : highCut.sections )
+        fn(section);
+}
+
+void SIMDFilterEngine::prepareRamp(size_t numSamples)
+{
+    // ramps that are started together run together, anything still
+    // going from an earlier call of a different length gets finished first.
+    if( rampSamplesRemaining != 0 && rampSamplesRemaining != numSamples )
+        advanceRamp(rampSamplesRemaining);
+
+    rampSamplesRemaining = numSamples;
+}
+
+void SIMDFilterEngine::advanceRamp(size_t numSamples) noexcept
+{
+    if( rampSamplesRemaining == 0 )
+        return;
+
+    numSamples = juce::jmin(numSamples, rampSamplesRemaining);
+    rampSamplesRemaining -= numSamples;
+
+    if( rampSamplesRemaining == 0 )
+        forEachSection([](Section& section) { section.finishRamp(); });
+    else
+        forEachSection([numSamples](Section& section) { section.advanceRamp(numSamples); });
+}
+
+//==============================================================================
+void SIMDFilterEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert(spec.numChannels <= MaxChannels);
+    numChannels = juce::jmin(static_cast<size_t>(spec.numChannels), MaxChannels);
+    numLaneGroups = (numChannels + NumLanes - 1) / NumLanes;
+
+    interleaved.assign(spec.maximumBlockSize, SIMDType::expand(0.f));
+
+    reset();
+    updateCascade();
+}
+
+void SIMDFilterEngine::reset()
+{
+    for( auto& group : states )
+        group.fill({});
+}
+
+void SIMDFilterEngine::setCoefficients(const FilterCoefficients& coefficients)
+{
+    setLowCut(coefficients.lowCut);
+    setPeak(coefficients.peak, coefficients.peakBypassed);
+    setHighCut(coefficients.highCut);
+}
+
+void SIMDFilterEngine::setLowCut(const CutCoefficients& coefficients)
+{
+    lowCut.setCoefficients(coefficients);
+    updateCascade();
+}
+
+void SIMDFilterEngine::setPeak(const BiquadCoefficients& coefficients, bool bypassed)
+{
+    peak.setCoefficients(coefficients);
+    peakBypassed = bypassed;
+    updateCascade();
+}
+
+void SIMDFilterEngine::setHighCut(const CutCoefficients& coefficients)
+{
+    highCut.setCoefficients(coefficients);
+    updateCascade();
+}
+
+void SIMDFilterEngine::rampLowCut(const CutCoefficients& coefficients, size_t numSamples)
+{
+    jassert(coefficients.getNumSections() == lowCut.numSections);
+    jassert(coefficients.bypassed == lowCut.bypassed);
+    prepareRamp(numSamples);
+
+    for( int i = 0; i < lowCut.numSections; ++i )
+        lowCut.sections[i].rampTo(coefficients.sections[i], numSamples);
+}
+
+void SIMDFilterEngine::rampPeak(const BiquadCoefficients& coefficients, size_t numSamples)
+{
+    prepareRamp(numSamples);
+    peak.rampTo(coefficients, numSamples);
+}
+
+void SIMDFilterEngine::rampHighCut(const CutCoefficients& coefficients, size_t numSamples)
+{
+    jassert(coefficients.getNumSections() == highCut.numSections);
+    jassert(coefficients.bypassed == highCut.bypassed);
+    prepareRamp(numSamples);
+
+    for( int i = 0; i < highCut.numSections; ++i )
+        highCut.sections[i].rampTo(coefficients.sections[i], numSamples);
+}
+
+void SIMDFilterEngine::update(const ChainSettings& chainSettings, double sampleRate)
+{
+    setCoefficients(designFilterCoefficients(chainSettings, sampleRate));
+}
+
+//==============================================================================
+void SIMDFilterEngine::process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    auto& block = context.getOutputBlock();
+    const auto totalNumSamples = block.getNumSamples();
+
+    if( context.isBypassed || numActiveSections == 0 )
+    {
+        advanceRamp(totalNumSamples);
+        return;
+    }
+
+    jassert(block.getNumChannels() <= numChannels);
+
+    const auto maxBlockSize = interleaved.size();
+    const auto groups = juce::jmin(numLaneGroups, (block.getNumChannels() + NumLanes - 1) / NumLanes);
+
+    // hosts shouldn't send more than maximumBlockSize, but don't fall over if they do
+    for( size_t start = 0; start < totalNumSamples; )
+    {
+        auto numSamples = juce::jmin(maxBlockSize, totalNumSamples - start);
+        auto ramping = rampSamplesRemaining > 0;
+
+        if( ramping )
+            numSamples = juce::jmin(numSamples, rampSamplesRemaining);
+
+        auto kernel = ramping ? rampingCascade : cascade;
+        auto* samples = interleaved.data();
+
+        for( size_t group = 0; group < groups; ++group )
+        {
+            const auto firstChannel = group * NumLanes;
+
+            interleave(block, firstChannel, start, numSamples);
+            kernel(activeSections.data(), activeStates[group].data(), samples, numSamples);
+            deinterleave(block, firstChannel, start, numSamples);
+        }
+
+        advanceRamp(numSamples);
+        start += numSamples;
+    }
+}
+
+void SIMDFilterEngine::interleave(const juce::dsp::AudioBlock<float>& block,
+                                  size_t firstChannel,
+                                  size_t startSample,
+                                  size_t numSamples) noexcept
+{
+    auto* dest = reinterpret_cast<float*>(interleaved.data());
+    auto lanes = juce::jmin(block.getNumChannels() - firstChannel, NumLanes);
+
+    for( size_t lane = 0; lane < lanes; ++lane )
+    {
+        auto* src = block.getChannelPointer(firstChannel + lane) + startSample;
+
+        for( size_t i = 0; i < numSamples; ++i )
+            dest[i * NumLanes + lane] = src[i];
+    }
+
+    // spare lanes of a partly filled group are kept at zero, so they can't pick up
+    // another group's samples or run into denormals and NaNs
+    for( size_t lane = lanes; lane < NumLanes; ++lane )
+    {
+        for( size_t i = 0; i < numSamples; ++i )
+            dest[i * NumLanes + lane] = 0.f;
+    }
+}
+
+void SIMDFilterEngine::deinterleave(juce::dsp::AudioBlock<float>& block,
+                                    size_t firstChannel,
+                                    size_t startSample,
+                                    size_t numSamples) noexcept
+{
+    auto* src = reinterpret_cast<const float*>(interleaved.data());
+    auto lanes = juce::jmin(block.getNumChannels() - firstChannel, NumLanes);
+
+    for( size_t lane = 0; lane < lanes; ++lane )
+    {
+        auto* dest = block.getChannelPointer(firstChannel + lane) + startSample;
+
+        for( size_t i = 0; i < numSamples; ++i )
+            dest[i] = src[i * NumLanes + lane];
+    }
+}
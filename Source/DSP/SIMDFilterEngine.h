@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    SIMDFilterEngine.h
+    Created: 17 Oct 2026 10:42:19am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterCoefficients.h"
+
+/**
+ Runs the low cut, peak and high cut chain for several channels in one pass.
+
+ Every channel gets one lane of a juce::dsp::SIMDRegister, so the filter state
+ of all channels lives interleaved in the same registers and each biquad
+ processes all channels with one multiply-add per coefficient.
+ Channels are packed NumLanes at a time into lane groups (3 groups of 4 for a 7.1.4 bus),
+ and all channels share the same coefficients.
+
+ The active sections of all three bands run as one fused cascade: every sample
+ goes through all of them while the filter state stays in locals, so the block
+ is swept once no matter how many sections are active. The cascade is a template
+ on the number of active sections, picked from a table whenever the settings change.
+
+ The ramp functions move a band's coefficients linearly to new ones over the next
+ numSamples samples. That's what the CoefficientSmoother uses between the points
+ where it redesigns, so automation doesn't step once per block.
+ */
+struct SIMDFilterEngine
+{
+    using SIMDType = juce::dsp::SIMDRegister<float>;
+    static constexpr size_t NumLanes = SIMDType::SIMDNumElements;
+
+    // enough for 7.1.4
+    static constexpr size_t MaxChannels = 12;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void process(const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+    //==============================================================================
+    void setCoefficients(const FilterCoefficients& coefficients);
+    void setLowCut(const CutCoefficients& lowCut);
+    void setPeak(const BiquadCoefficients& peak, bool bypassed);
+    void setHighCut(const CutCoefficients& highCut);
+
+    // the slope and bypass state of a band can't be ramped, only its coefficients.
+    void rampLowCut(const CutCoefficients& lowCut, size_t numSamples);
+    void rampPeak(const BiquadCoefficients& peak, size_t numSamples);
+    void rampHighCut(const CutCoefficients& highCut, size_t numSamples);
+
+    /** designs on the calling thread, handy for offline tools that don't run a CoefficientDesigner. */
+    void update(const ChainSettings& chainSettings, double sampleRate);
+
+    size_t getNumChannels() const { return numChannels; }
+private:
+    /** coefficients, broadcast to every lane */
+    struct Section
+    {
+        SIMDType b0 = SIMDType::expand(1.f), b1 = SIMDType::expand(0.f), b2 = SIMDType::expand(0.f);
+        SIMDType a1 = SIMDType::expand(0.f), a2 = SIMDType::expand(0.f);
+
+        // per sample increments while ramping, zero otherwise
+        SIMDType db0 = SIMDType::expand(0.f), db1 = SIMDType::expand(0.f), db2 = SIMDType::expand(0.f);
+        SIMDType da1 = SIMDType::expand(0.f), da2 = SIMDType::expand(0.f);
+
+        BiquadCoefficients target;
+        bool ramping { false };
+
+        void setCoefficients(const BiquadCoefficients& coefficients) noexcept;
+        void rampTo(const BiquadCoefficients& coefficients, size_t numSamples) noexcept;
+        void advanceRamp(size_t numSamples) noexcept;
+        void finishRamp() noexcept;
+    };
+
+    /** filter state, one per section per lane group */
+    struct State
+    {
+        SIMDType s1 = SIMDType::expand(0.f), s2 = SIMDType::expand(0.f);
+    };
+
+    struct Cut
+    {
+        std::array<Section, MaxCutSections> sections;
+        int numSections { 1 };
+        bool bypassed { false };
+
+        void setCoefficients(const CutCoefficients& coefficients) noexcept;
+    };
+
+    Cut lowCut, highCut;
+    Section peak;
+    bool peakBypassed { false };
+
+    //==============================================================================
+    // lowcut 4 + peak 1 + highcut 4
+    static constexpr int MaxActiveSections = 2 * MaxCutSections + 1;
+    static constexpr size_t MaxLaneGroups = (MaxChannels + NumLanes - 1) / NumLanes;
+
+    // where each section keeps its state in a lane group
+    static constexpr int LowCutStateIndex = 0;
+    static constexpr int PeakStateIndex = MaxCutSections;
+    static constexpr int HighCutStateIndex = MaxCutSections + 1;
+
+    using CascadeFunction = void (*)(const Section* const* sections,
+                                     State* const* states,
+                                     SIMDType* samples,
+                                     size_t numSamples);
+
+    template<int NumSections, bool Ramping>
+    static void processCascade(const Section* const* sections,
+                               State* const* states,
+                               SIMDType* samples,
+                               size_t numSamples) noexcept;
+
+    static CascadeFunction getCascadeFunction(int numSections, bool ramping) noexcept;
+
+    /** collects the sections that aren't bypassed, in processing order, and picks the matching kernel. */
+    void updateCascade() noexcept;
+
+    std::array<std::array<State, MaxActiveSections>, MaxLaneGroups> states;
+
+    std::array<const Section*, MaxActiveSections> activeSections {};
+    std::array<std::array<State*, MaxActiveSections>, MaxLaneGroups> activeStates {};
+    int numActiveSections { 0 };
+    CascadeFunction cascade { nullptr }, rampingCascade { nullptr };
+
+    //==============================================================================
+    template<typename Fn>
+    void forEachSection(Fn&& fn);
+
+    void prepareRamp(size_t numSamples);
+    void advanceRamp(size_t numSamples) noexcept;
+
+    size_t rampSamplesRemaining { 0 };
+
+    //==============================================================================
+    void interleave(const juce::dsp::AudioBlock<float>& block,
+                    size_t firstChannel,
+                    size_t startSample,
+                    size_t numSamples) noexcept;
+    void deinterleave(juce::dsp::AudioBlock<float>& block,
+                      size_t firstChannel,
+                      size_t startSample,
+                      size_t numSamples) noexcept;
+
+    std::vector<SIMDType> interleaved;
+    size_t numChannels { 0 };
+    size_t numLaneGroups { 0 };
+};
@@ -11,7 +11,6 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "Fifo.h"
 
 enum Channel
 {
@@ -19,67 +18,106 @@ enum Channel
     Left //effectively 1
 };
 
+/**
+ The analyzer tap: a lock-free single producer / single consumer ring of the newest samples of one channel.
+
+ The audio thread copies every block in with at most two memcpys and never waits.
+ The analyzer reads whatever window it wants by absolute sample position, straight
+ out of the ring, without the ring shifting anything. Old samples just get overwritten,
+ read() notices when that happened to the window it was copying.
+ */
 template<typename BlockType>
 struct SingleChannelSampleFifo
 {
+    // the longest window the analyzer reads (its 32768 point FFT), the ring keeps a few
+    // of them so the audio thread can keep writing while one is being copied out.
+    static constexpr int MaxWindowSize = 1 << 15;
+    static constexpr int Capacity = 4 * MaxWindowSize;
+
     SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
     {
+        static_assert((Capacity & (Capacity - 1)) == 0, "the ring relies on Capacity being a power of 2");
+        
+        // allocated once, so prepare() can't pull the memory out from under the analyzer
+        samples.resize(Capacity, 0.f);
         prepared.set(false);
     }
     
     void update(const BlockType& buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse );
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
+        
+        // on a mono bus both analyzer taps read the only channel there is
+        auto channel = juce::jmin(static_cast<int>(channelToUse), buffer.getNumChannels() - 1);
+        auto* source = buffer.getReadPointer(channel);
+        auto numSamples = buffer.getNumSamples();
+        auto start = writePosition.load(std::memory_order_relaxed);
         
-        for( int i = 0; i < buffer.getNumSamples(); ++i )
+        // only the newest Capacity samples fit anyway
+        if( numSamples > Capacity )
         {
-            pushNextSampleIntoFifo(channelPtr[i]);
+            source += numSamples - Capacity;
+            start += numSamples - Capacity;
+            numSamples = Capacity;
         }
+        
+        // claim before writing, so a reader can tell its window got overwritten
+        claimedPosition.store(start + numSamples, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        auto index = static_cast<int>(start & Mask);
+        auto firstSpan = juce::jmin(numSamples, Capacity - index);
+        
+        std::memcpy(samples.data() + index, source, sizeof(float) * static_cast<size_t>(firstSpan));
+        std::memcpy(samples.data(), source + firstSpan, sizeof(float) * static_cast<size_t>(numSamples - firstSpan));
+        
+        writePosition.store(start + numSamples, std::memory_order_release);
     }
 
     void prepare(int bufferSize)
     {
-        prepared.set(false);
-        size.set(bufferSize);
+        // any block size works, the ring doesn't care
+        juce::ignoreUnused(bufferSize);
         
-        bufferToFill.setSize(1,             //channel
-                             bufferSize,    //num samples
-                             false,         //keepExistingContent
-                             true,          //clear extra space
-                             true);         //avoid reallocating
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
+        prepared.set(false);
+        claimedPosition = 0;
+        writePosition = 0;
         prepared.set(true);
     }
     //==============================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
     bool isPrepared() const { return prepared.get(); }
-    int getSize() const { return size.get(); }
-    //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
-private:
-    Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
-    juce::Atomic<bool> prepared = false;
-    juce::Atomic<int> size = 0;
     
-    void pushNextSampleIntoFifo(float sample)
+    /** how many samples have been written in total, the end of the newest window. */
+    juce::int64 getWritePosition() const { return writePosition.load(std::memory_order_acquire); }
+    
+    /**
+     copies numSamples starting at the absolute position 'start' into destination.
+     returns false if they haven't all been written yet, or if the audio thread
+     overwrote some of them before they were copied out.
+     */
+    bool read(float* destination, juce::int64 start, int numSamples) const
     {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
-
-            juce::ignoreUnused(ok);
-            
-            fifoIndex = 0;
-        }
+        jassert(numSamples <= Capacity);
+        
+        auto end = writePosition.load(std::memory_order_acquire);
+        if( start < 0 || start + numSamples > end || end - start > Capacity )
+            return false;
+        
+        auto index = static_cast<int>(start & Mask);
+        auto firstSpan = juce::jmin(numSamples, Capacity - index);
         
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
+        std::memcpy(destination, samples.data() + index, sizeof(float) * static_cast<size_t>(firstSpan));
+        std::memcpy(destination + firstSpan, samples.data(), sizeof(float) * static_cast<size_t>(numSamples - firstSpan));
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return claimedPosition.load(std::memory_order_relaxed) - start <= Capacity;
     }
+private:
+    static constexpr juce::int64 Mask = Capacity - 1;
+    
+    Channel channelToUse;
+    std::vector<float> samples;
+    std::atomic<juce::int64> writePosition { 0 }, claimedPosition { 0 };
+    juce::Atomic<bool> prepared = false;
 };
-
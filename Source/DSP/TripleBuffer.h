@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026 9:20:47am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ Wait-free single producer / single consumer handoff of the latest value.
+
+ The writer fills getWriteSlot() and calls publish(), the reader calls
+ acquireLatest() and then uses getReadSlot(). Both sides only ever swap
+ an index, so neither side can block the other and nothing is copied.
+ Slots are preallocated, so T may own memory as long as it is sized before use.
+ */
+template<typename T>
+struct TripleBuffer
+{
+    //==============================================================================
+    // writer side
+    T& getWriteSlot() { return slots[writeIndex]; }
+
+    void publish()
+    {
+        auto previous = middle.exchange(writeIndex | FreshFlag, std::memory_order_acq_rel);
+        writeIndex = previous & IndexMask;
+    }
+
+    //==============================================================================
+    // reader side
+    /**
+     swaps in the newest published slot.
+     returns false (and leaves the read slot untouched) if nothing new was published.
+     */
+    bool acquireLatest()
+    {
+        if( (middle.load(std::memory_order_acquire) & FreshFlag) == 0 )
+            return false;
+
+        auto previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & IndexMask;
+        return true;
+    }
+
+    const T& getReadSlot() const { return slots[readIndex]; }
+    T& getReadSlot() { return slots[readIndex]; }
+
+    //==============================================================================
+    /** only call this when neither side is running, e.g. to size the slots. */
+    template<typename Fn>
+    void forEachSlot(Fn&& fn)
+    {
+        for( auto& slot : slots )
+            fn(slot);
+    }
+private:
+    static constexpr int FreshFlag = 4;
+    static constexpr int IndexMask = 3;
+
+    std::array<T, 3> slots;
+    int writeIndex = 0;
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;
+};
@@ -12,70 +12,107 @@
 
 #include <JuceHeader.h>
 #include "Utilities.h"
-
+#include "SpectrumColumns.h"
+#include "../DSP/Fifo.h"
+
+/**
+ Draws a spectrum with exactly one vertex per pixel column.
+ 
+ The spectrum can be one FFT's bins, or a frame stitched together from several bands
+ of different resolution. SpectrumColumns works out which bins land in which column,
+ once per band layout and width.
+ */
 template<typename PathType>
 struct AnalyzerPathGenerator
 {
     /*
-     converts 'renderData[]' into a juce::Path
+     converts 'renderData[]' into a juce::Path, built in place in a free slot of the fifo.
      */
     void generatePath(const std::vector<float>& renderData,
                       juce::Rectangle<float> fftBounds,
                       int fftSize,
                       float binWidth,
                       float negativeInfinity)
+    {
+        // a single band of everything but DC
+        singleBand.resize(1);
+        auto& band = singleBand.front();
+        band.offset = 1;
+        band.firstBin = 1;
+        band.numBins = fftSize / 2 - 1;
+        band.binWidth = binWidth;
+        band.lowestFrequency = 0.f;
+        band.highestFrequency = std::numeric_limits<float>::max();
+        
+        generatePath(renderData, fftBounds, singleBand, negativeInfinity);
+    }
+    
+    /*
+     converts a stitched frame into a juce::Path, 'bands' says where each band sits in 'renderData[]'.
+     */
+    void generatePath(const std::vector<float>& renderData,
+                      juce::Rectangle<float> fftBounds,
+                      const std::vector<SpectrumBand>& bands,
+                      float negativeInfinity)
     {
         auto top = fftBounds.getY();
         auto bottom = fftBounds.getHeight();
-        auto width = fftBounds.getWidth();
-
-        int numBins = (int)fftSize / 2;
-
-        PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
-
+        auto width = (int)fftBounds.getWidth();
+        
+        if( width <= 0 || bands.empty() )
+            return;
+        
+        columns.update(bands, width);
+        
+        auto* slot = pathFifo.acquireWrite();
+        if( slot == nullptr )
+            return;
+        
+        // clear() keeps the storage, so this only allocates the first few times round
+        auto& p = *slot;
+        p.clear();
+        p.preallocateSpace(3 * width);
+        
         auto map = [bottom, top, negativeInfinity](float v)
         {
-            return juce::jmap(v,
-                              negativeInfinity, 0.f,
-                              float(bottom+10),   top);
+            auto y = juce::jmap(v,
+                                negativeInfinity, 0.f,
+                                float(bottom+10),   top);
+            
+            return std::isfinite(y) ? y : bottom;
         };
-
-        auto y = map(renderData[0]);
-
-        if( std::isnan(y) || std::isinf(y) )
-            y = bottom;
         
-        p.startNewSubPath(0, y);
-
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
-
-        for( int binNum = 1; binNum < numBins; binNum += pathResolution )
+        const auto* data = renderData.data();
+        
+        for( int x = 0; x < width; ++x )
         {
-            y = map(renderData[binNum]);
-
-            if( !std::isnan(y) && !std::isinf(y) )
-            {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY, MAX_FREQUENCY);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
-            }
+            auto v = columns.getValue(data, x);
+            
+            if( x == 0 )
+                p.startNewSubPath(0, map(v));
+            else
+                p.lineTo(x, map(v));
         }
-
-        pathFifo.push(p);
+        
+        pathFifo.commitWrite();
     }
-
+    
     int getNumPathsAvailable() const
     {
         return pathFifo.getNumAvailableForReading();
     }
 
+    /** swaps the oldest path into 'path', the fifo reuses path's old storage. */
     bool getPath(PathType& path)
     {
         return pathFifo.pull(path);
     }
+    
+    int getNumDroppedPaths() const { return pathFifo.getNumDroppedPushes(); }
 private:
+    SpectrumColumns columns;
+    std::vector<SpectrumBand> singleBand;
+    
     Fifo<PathType> pathFifo;
 };
 
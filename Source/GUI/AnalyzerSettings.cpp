@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    AnalyzerSettings.cpp
+    Created: 17 Oct 2026 6:03:27pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "AnalyzerSettings.h"
+
+AnalyzerSettings getAnalyzerSettings(juce::AudioProcessorValueTreeState& apvts)
+{
+    AnalyzerSettings settings;
+    
+    settings.order = static_cast<FFTOrder>(FFTOrder::order2048 + static_cast<int>(apvts.getRawParameterValue("Analyzer FFT Size")->load()));
+    settings.window = static_cast<AnalyzerWindow>(apvts.getRawParameterValue("Analyzer Window")->load());
+    settings.calibration = static_cast<AnalyzerCalibration>(apvts.getRawParameterValue("Analyzer Calibration")->load());
+    settings.mode = static_cast<AnalyzerMode>(apvts.getRawParameterValue("Analyzer Mode")->load());
+    settings.overlap = static_cast<AnalyzerOverlap>(apvts.getRawParameterValue("Analyzer Overlap")->load());
+    settings.averaging = static_cast<AnalyzerAveraging>(apvts.getRawParameterValue("Analyzer Averaging")->load());
+    settings.response = static_cast<AnalyzerResponse>(apvts.getRawParameterValue("Analyzer Response")->load());
+    settings.peakHold = apvts.getRawParameterValue("Analyzer Peak Hold")->load() > 0.5f;
+    settings.view = static_cast<AnalyzerView>(apvts.getRawParameterValue("Analyzer View")->load());
+    
+    return settings;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    AnalyzerSettings.h
+    Created: 17 Oct 2026 6:03:27pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum FFTOrder
+{
+    order2048 = 11,
+    order4096 = 12,
+    order8192 = 13,
+    order16384 = 14,
+    order32768 = 15
+};
+
+enum AnalyzerWindow
+{
+    BlackmanHarris,
+    Hann,
+    FlatTop
+};
+
+/** what the analyzer's two traces show. */
+enum AnalyzerMode
+{
+    LeftRight,  // one complex FFT for both channels
+    MidSide,    // same, on (L+R)/2 and (L-R)/2
+    MonoSum     // one real FFT of (L+R)/2 per band, a single trace
+};
+
+/** what reads the same in every band of the multi-resolution analyzer. */
+enum AnalyzerCalibration
+{
+    SineCalibration,    // a sine reads its peak level, noise reads 3 dB lower per band down
+    NoiseCalibration    // white noise reads flat, a sine reads 3 dB higher per band down
+};
+
+enum AnalyzerOverlap
+{
+    Overlap_0,      // hop = fftSize
+    Overlap_50,     // hop = fftSize / 2
+    Overlap_75,     // hop = fftSize / 4
+    Overlap_87_5    // hop = fftSize / 8
+};
+
+/** how consecutive frames get combined before they're drawn. */
+enum AnalyzerAveraging
+{
+    NoAveraging,
+    ExponentialAveraging,   // a one pole smoother per bin
+    WelchAveraging          // the mean of the last few frames
+};
+
+/** how the spectrum gets drawn. */
+enum AnalyzerView
+{
+    LineView,           // a trace per channel, averaged
+    SpectrogramView     // a scrolling waterfall of the raw frames, newest at the top
+};
+
+enum AnalyzerResponse
+{
+    Response_Fast,
+    Response_Medium,
+    Response_Slow
+};
+
+struct AnalyzerSettings
+{
+    /** the resolution of the analyzer's lowest band, as the size of the single FFT that would match it. */
+    FFTOrder order { FFTOrder::order16384 };
+    AnalyzerWindow window { AnalyzerWindow::BlackmanHarris };
+    AnalyzerCalibration calibration { AnalyzerCalibration::SineCalibration };
+    
+    AnalyzerMode mode { AnalyzerMode::LeftRight };
+    AnalyzerOverlap overlap { AnalyzerOverlap::Overlap_50 };
+    
+    /** how far apart in samples the ends of consecutive analysis windows are. */
+    int getHopSize(int fftSize) const { return fftSize >> static_cast<int>(overlap); }
+    
+    AnalyzerAveraging averaging { AnalyzerAveraging::ExponentialAveraging };
+    AnalyzerResponse response { AnalyzerResponse::Response_Medium };
+    bool peakHold { false };
+    
+    AnalyzerView view { AnalyzerView::LineView };
+    
+    /** the time constant of the exponential averaging. */
+    float getAveragingTime() const
+    {
+        static constexpr float times[] { 0.1f, 0.3f, 1.f };
+        return times[response];
+    }
+    
+    /** how many frames the Welch averaging takes the mean of. */
+    int getNumWelchFrames() const { return 4 << static_cast<int>(response); }
+};
+
+AnalyzerSettings getAnalyzerSettings(juce::AudioProcessorValueTreeState& apvts);
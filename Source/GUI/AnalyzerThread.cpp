@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.cpp
+    Created: 17 Oct 2026 5:12:40pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "AnalyzerThread.h"
+#include "LookAndFeel.h"
+
+AnalyzerThread::AnalyzerThread(SimpleEQAudioProcessor& p) :
+juce::Thread("Analyzer"),
+audioProcessor(p),
+pathProducer(audioProcessor.leftChannelFifo, audioProcessor.rightChannelFifo)
+{
+    startThread();
+}
+
+AnalyzerThread::~AnalyzerThread()
+{
+    stopThread(1000);
+}
+
+void AnalyzerThread::setAnalysisBounds(juce::Rectangle<float> bounds, float scale)
+{
+    {
+        const juce::SpinLock::ScopedLockType sl(boundsLock);
+        analysisBounds = bounds;
+        analysisScale = scale;
+    }
+
+    needsRender = true;
+    notify();
+}
+
+void AnalyzerThread::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+    needsRender = true;
+    notify();
+}
+
+void AnalyzerThread::setResponseCurve(const juce::Path& curve)
+{
+    responseCurves.getWriteSlot() = curve;
+    responseCurves.publish();
+    notify();
+}
+
+void AnalyzerThread::run()
+{
+    // everything the analyzer needs gets allocated here, so switching its settings later doesn't
+    pathProducer.prepare();
+
+    while( ! threadShouldExit() )
+    {
+        // until the next vblank, or forever while the editor isn't showing
+        wait(-1);
+
+        if( threadShouldExit() )
+            break;
+
+        juce::Rectangle<float> bounds;
+        float scale;
+        {
+            const juce::SpinLock::ScopedLockType sl(boundsLock);
+            bounds = analysisBounds;
+            scale = analysisScale;
+        }
+
+        if( bounds.isEmpty() )
+            continue;
+
+        bool changed = needsRender.exchange(false);
+        changed = responseCurves.acquireLatest() || changed;
+
+        if( enabled )
+        {
+            auto sampleRate = audioProcessor.getSampleRate();
+            auto settings = getAnalyzerSettings(audioProcessor.apvts);
+
+            pathProducer.process(bounds, scale, sampleRate, settings);
+            changed = pathProducer.pullLatestPaths() || changed;
+            
+            if( settings.view != renderedView )
+            {
+                renderedView = settings.view;
+                changed = true;
+            }
+        }
+
+        if( changed )
+            render(bounds, scale);
+    }
+}
+
+void AnalyzerThread::render(juce::Rectangle<float> bounds, float scale)
+{
+    using namespace juce;
+
+    auto& slot = images.getWriteSlot();
+    const auto width = jmax(1, roundToInt(bounds.getWidth() * scale));
+    const auto height = jmax(1, roundToInt(bounds.getHeight() * scale));
+
+    // each slot only gets reallocated when the size or the scale changes.
+    // a software image, so it can be drawn into off the message thread.
+    if( slot.image.getWidth() != width || slot.image.getHeight() != height )
+        slot.image = Image(Image::PixelFormat::ARGB, width, height, true, SoftwareImageType());
+    else
+        slot.image.clear(slot.image.getBounds());
+
+    slot.bounds = bounds;
+
+    {
+        Graphics g(slot.image);
+        g.addTransform(AffineTransform::scale(scale));
+
+        // the analyzer paths are relative to the analysis area already, the curve is in the component's coordinates
+        if( enabled && renderedView == AnalyzerView::LineView )
+        {
+            g.setColour(ColorScheme::getLeftOutputSignalColor());
+            g.strokePath(pathProducer.getPath(0), PathStrokeType(1));
+
+            g.setColour(ColorScheme::getRightOutputSignalColor());
+            g.strokePath(pathProducer.getPath(1), PathStrokeType(1));
+
+            // the held peaks, fainter, over the averages (empty unless peak hold is on)
+            g.setColour(ColorScheme::getLeftOutputSignalColor().withAlpha(0.5f));
+            g.strokePath(pathProducer.getPeakPath(0), PathStrokeType(1));
+
+            g.setColour(ColorScheme::getRightOutputSignalColor().withAlpha(0.5f));
+            g.strokePath(pathProducer.getPeakPath(1), PathStrokeType(1));
+        }
+
+        g.setColour(ColorScheme::getFFTLineColor());
+        g.strokePath(responseCurves.getReadSlot(), PathStrokeType(2.f),
+                     AffineTransform::translation(-bounds.getX(), -bounds.getY()));
+    }
+
+    images.publish();
+}
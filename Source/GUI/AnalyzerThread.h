@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    AnalyzerThread.h
+    Created: 17 Oct 2026 5:12:40pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PathProducer.h"
+
+/** the analysis area, rendered at the display's scale. */
+struct AnalysisImage
+{
+    juce::Image image;
+
+    // where it goes in the component. the image is these bounds times the scale it was rendered at.
+    juce::Rectangle<float> bounds;
+};
+
+/**
+ Runs the PathProducer on its own thread, once per display refresh.
+ The editor's vblank wakes it up through requestImage(), so it sleeps while
+ nothing is on screen.
+
+ Whenever new analyzer paths or a new response curve come in, it strokes them
+ into an AnalysisImage at the display's scale and publishes that through a TripleBuffer,
+ so the message thread's paint() only blits the newest image. How long that takes
+ doesn't depend on how many vertices the paths have.
+ In the spectrogram view the image only has the curve, and the rows come through pullSpectrogramRow().
+ */
+struct AnalyzerThread : juce::Thread
+{
+    AnalyzerThread(SimpleEQAudioProcessor& processor);
+    ~AnalyzerThread() override;
+
+    /** where the analysis area is in the component, and how many pixels a unit of it is on the display. */
+    void setAnalysisBounds(juce::Rectangle<float> bounds, float scale);
+    void setEnabled(bool shouldBeEnabled);
+
+    //==============================================================================
+    // message thread
+    /** hands the curve over, in the component's coordinates, and renders it into the next image. */
+    void setResponseCurve(const juce::Path& curve);
+
+    /** wakes the thread up to analyze whatever the taps got since last time. */
+    void requestImage() { notify(); }
+
+    /** swaps in the newest image. returns false if there wasn't one since the last call. */
+    bool pullLatestImage() { return images.acquireLatest(); }
+    const AnalysisImage& getImage() const { return images.getReadSlot(); }
+    
+    /** swaps the oldest spectrogram row into 'row'. false if there are no more. */
+    bool pullSpectrogramRow(SpectrogramRow& row) { return pathProducer.getSpectrogramRow(row); }
+private:
+    void run() override;
+
+    /** strokes the analyzer paths and the curve into the image's write slot and publishes it. */
+    void render(juce::Rectangle<float> bounds, float scale);
+
+    SimpleEQAudioProcessor& audioProcessor;
+    PathProducer pathProducer;
+
+    juce::SpinLock boundsLock;    // only held for a copy
+    juce::Rectangle<float> analysisBounds;
+    float analysisScale { 1.f };
+
+    std::atomic<bool> enabled { true };
+    
+    // the paths only go in the image in the line view. analyzer thread only.
+    AnalyzerView renderedView { AnalyzerView::LineView };
+
+    // the bounds, the scale or enabled changed, so the last image is out of date
+    std::atomic<bool> needsRender { true };
+
+    TripleBuffer<juce::Path> responseCurves;
+    TripleBuffer<AnalysisImage> images;
+};
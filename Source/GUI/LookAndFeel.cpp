@@ -11,6 +11,86 @@
 #include "LookAndFeel.h"
 #include "RotarySliderWithLabels.h"
 
+namespace
+{
+/** how many angles a knob snaps to, about one every two pixels its pointer's tip moves. */
+int getNumKnobFrames(int width, float rotaryStartAngle, float rotaryEndAngle)
+{
+    auto tipTravel = (rotaryEndAngle - rotaryStartAngle) * width * 0.5f;
+    return juce::jlimit(32, 128, (int)std::ceil(tipTravel * 0.5f)) + 1;
+}
+
+/** the knob and its pointer, everything drawRotarySlider() draws but the value. */
+void drawKnob(juce::Graphics& g,
+              juce::Rectangle<float> bounds,
+              bool enabled,
+              float pointerAngle,
+              float pointerLength)
+{
+    using namespace juce;
+    
+    g.setColour(enabled ? ColorScheme::getSliderFillColor() : Colours::darkgrey);
+    g.fillEllipse(bounds);
+    
+    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::grey);
+    g.drawEllipse(bounds, 1.f);
+    
+    if( pointerLength <= 0.f )
+        return;
+    
+    auto center = bounds.getCentre();
+    Path p;
+    
+    Rectangle<float> r;
+    r.setLeft(center.getX() - 2);
+    r.setRight(center.getX() + 2);
+    r.setTop(bounds.getY());
+    r.setBottom(bounds.getY() + pointerLength);
+    
+    p.addRoundedRectangle(r, 2.f);
+    p.addRectangle(r);
+    
+    p.applyTransform(AffineTransform().rotated(pointerAngle, center.getX(), center.getY()));
+    
+    g.fillPath(p);
+}
+
+void drawPowerButton(juce::Graphics& g, juce::Rectangle<int> bounds, bool toggleState)
+{
+    using namespace juce;
+    
+    Path powerButton;
+    
+    auto size = juce::jmin(bounds.getWidth(), bounds.getHeight()) - 10;
+    auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
+    
+    float ang = 30.f;
+    
+    size -= -6;
+    
+    powerButton.addCentredArc(r.getCentreX(),
+                              r.getCentreY(),
+                              size * 0.5,
+                              size * 0.5,
+                              0.f,
+                              degreesToRadians(ang),
+                              degreesToRadians(360 - ang),
+                              true);
+    powerButton.startNewSubPath(r.getCentreX(), r.getY());
+    powerButton.lineTo(r.getCentre());
+    
+    PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
+    
+    g.strokePath(powerButton, pst);
+    
+    auto color = toggleState ? Colours::dimgrey : ColorScheme::getBypassButtonColor();
+    
+    g.setColour(color);
+    g.strokePath(powerButton, pst);
+    g.drawEllipse(r, 2);
+}
+}
+
 void LookAndFeel::drawRotarySlider(juce::Graphics& g,
                                   int x,
                                   int y,
@@ -23,37 +103,47 @@ void LookAndFeel::drawRotarySlider(juce::Graphics& g,
 {
     using namespace juce;
     
+#if USE_LIVE_CONSTANT
+    // the colours can change under the sprites
+    sprites.clear();
+#endif
+    
     auto bounds = Rectangle<float>(x, y, width, height);
     
+    if( bounds.isEmpty() )
+        return;
+    
     auto enabled = slider.isEnabled();
+    auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider);
     
-    g.setColour(enabled ? ColorScheme::getSliderFillColor() : Colours::darkgrey);
-    g.fillEllipse(bounds);
+    jassert(rotaryStartAnggle < rotaryEndAngle);
     
-    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : Colours::grey);
-    g.drawEllipse(bounds, 1.f);
+    // the pointer snaps to the nearest frame, so a drag only ever blits one
+    auto numFrames = getNumKnobFrames(width, rotaryStartAnggle, rotaryEndAngle);
+    auto frame = roundToInt(jlimit(0.f, 1.f, sliderPosProportional) * (numFrames - 1));
+    auto sliderAngRad = jmap(float(frame), 0.f, float(numFrames - 1), rotaryStartAnggle, rotaryEndAngle);
+    
+    // from the top of the knob to just above the value
+    auto pointerLength = rswl != nullptr ? bounds.getHeight() * 0.5f - rswl->getTextHeight() * 1.5f : 0.f;
+    
+    SpriteCache::Key key;
+    key.sprite = KnobSprite;
+    key.width = width;
+    key.height = height;
+    key.scale = SpriteCache::getScale(g);
+    key.state = enabled ? 1 : 0;
+    key.value = rswl != nullptr ? sliderAngRad : 0.f;
     
-    if(auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
+    auto& knob = sprites.get(key, [&](Graphics& sprite)
+    {
+        drawKnob(sprite, bounds.withZeroOrigin(), enabled, key.value, pointerLength);
+    });
+    
+    SpriteCache::draw(g, knob, bounds);
+    
+    if(rswl != nullptr)
     {
-        auto center = bounds.getCentre();
-        Path p;
-        
         Rectangle<float> r;
-        r.setLeft(center.getX() - 2);
-        r.setRight(center.getX() + 2);
-        r.setTop(bounds.getY());
-        r.setBottom(center.getY() - rswl->getTextHeight() * 1.5);
-        
-        p.addRoundedRectangle(r, 2.f);
-        p.addRectangle(r);
-        
-        jassert(rotaryStartAnggle < rotaryEndAngle);
-        
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAnggle, rotaryEndAngle);
-        
-        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
-        
-        g.fillPath(p);
         
         g.setFont(rswl->getTextHeight());
         auto text = rswl->getDisplayString();
@@ -79,36 +169,28 @@ void LookAndFeel::drawToggleButton(juce::Graphics &g,
     
     if(auto* pb = dynamic_cast<PowerButton*>(&toggleButton))
     {
-        Path powerButton;
-        
         auto bounds = toggleButton.getLocalBounds();
-        auto size = juce::jmin(bounds.getWidth(), bounds.getHeight()) - 10;
-        auto r = bounds.withSizeKeepingCentre(size, size).toFloat();
         
-        float ang = 30.f;
+        if( bounds.isEmpty() )
+            return;
         
-        size -= -6;
+#if USE_LIVE_CONSTANT
+        sprites.clear();
+#endif
         
-        powerButton.addCentredArc(r.getCentreX(),
-                                  r.getCentreY(),
-                                  size * 0.5,
-                                  size * 0.5,
-                                  0.f,
-                                  degreesToRadians(ang),
-                                  degreesToRadians(360 - ang),
-                                  true);
-        powerButton.startNewSubPath(r.getCentreX(), r.getY());
-        powerButton.lineTo(r.getCentre());
+        SpriteCache::Key key;
+        key.sprite = PowerButtonSprite;
+        key.width = bounds.getWidth();
+        key.height = bounds.getHeight();
+        key.scale = SpriteCache::getScale(g);
+        key.state = toggleButton.getToggleState() ? 1 : 0;
         
-        PathStrokeType pst(2.f, PathStrokeType::JointStyle::curved);
+        auto& powerButton = sprites.get(key, [&](Graphics& sprite)
+        {
+            drawPowerButton(sprite, bounds, toggleButton.getToggleState());
+        });
         
-        g.strokePath(powerButton, pst);
-        
-        auto color = toggleButton.getToggleState() ? Colours::dimgrey : ColorScheme::getBypassButtonColor();
-        
-        g.setColour(color);
-        g.strokePath(powerButton, pst);
-        g.drawEllipse(r, 2);
+        SpriteCache::draw(g, powerButton, bounds.toFloat());
     }
     else if( auto* analyzerButton = dynamic_cast<AnalyzerButton*>(&toggleButton) )
     {
@@ -9,6 +9,7 @@
 */
 #include <JuceHeader.h>
 #include "CustomButtons.h"
+#include "SpriteCache.h"
 
 #pragma once
 
@@ -42,9 +43,28 @@ inline juce::Colour getTickColor() { return colorHelper(juce::Colour(0xff404040)
 inline juce::Colour getMeterLineColor() { return colorHelper(juce::Colour(0xff3c3c3c)); }
 inline juce::Colour getScaleTextColor() { return juce::Colours::lightgrey; }
 inline juce::Colour getBypassButtonColor() { return juce::Colours::black; }
+
+/** the spectrogram's colours from negative infinity at 0 to 0 dB at 1, starting out as the analyzer background. */
+inline juce::ColourGradient getSpectrogramGradient()
+{
+    juce::ColourGradient gradient(getAnalyzerBackgroundColor(), 0.f, 0.f,
+                                  juce::Colours::white, 1.f, 0.f, false);
+    gradient.addColour(0.25, juce::Colour(0xff1a1a6e));
+    gradient.addColour(0.5, juce::Colour(0xff9b1d8a));
+    gradient.addColour(0.75, juce::Colour(0xfff27121));
+    gradient.addColour(0.9, juce::Colour(0xfffde64b));
+    return gradient;
+}
 }
 
 
+/**
+ The knobs and the power buttons come out of a SpriteCache: a knob is a frame per
+ step of its angle, a power button one per state, each rendered once per size and scale.
+ Dragging a knob blits a frame and draws its value on top.
+ One instance is shared through a juce::SharedResourcePointer by every slider and button
+ of every editor, so they all share the sprites too.
+ */
 struct LookAndFeel : juce::LookAndFeel_V4
 {
     void drawRotarySlider (juce::Graphics&,
@@ -58,4 +78,12 @@ struct LookAndFeel : juce::LookAndFeel_V4
                            juce::ToggleButton & toggleButton,
                            bool shouldDrawButtonAsHighlighted,
                            bool shouldDrawButtonAsDown) override;
+private:
+    enum Sprites
+    {
+        KnobSprite,
+        PowerButtonSprite
+    };
+    
+    SpriteCache sprites;
 };
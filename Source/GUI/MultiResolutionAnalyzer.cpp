@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    MultiResolutionAnalyzer.cpp
+    Created: 17 Oct 2026 9:14:22pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "MultiResolutionAnalyzer.h"
+#include "SpectrumKernels.h"
+
+namespace
+{
+int roundUpToAlignment(int numBins)
+{
+    return (numBins + MultiResolutionAnalyzer::BandAlignment - 1) / MultiResolutionAnalyzer::BandAlignment * MultiResolutionAnalyzer::BandAlignment;
+}
+}
+
+void MultiResolutionAnalyzer::HalfBandDecimator::prepare(const std::vector<float>& coefficients)
+{
+    length = static_cast<int>(coefficients.size());
+    jassert(length % 2 == 1);
+
+    const auto centre = length / 2;
+    centreCoefficient = coefficients[centre];
+
+    pairCoefficients.clear();
+    pairOffsets.clear();
+
+    // the filter is symmetric, so each pair of taps only needs one multiply
+    for( int offset = 1; offset <= centre; ++offset )
+    {
+        if( std::abs(coefficients[centre + offset]) > 1.0e-7f )
+        {
+            pairCoefficients.push_back(coefficients[centre + offset]);
+            pairOffsets.push_back(offset);
+        }
+    }
+
+    for( auto& line : lines )
+        line.assign(static_cast<size_t>(2 * length), 0.f);
+
+    reset();
+}
+
+void MultiResolutionAnalyzer::HalfBandDecimator::reset()
+{
+    for( auto& line : lines )
+        std::fill(line.begin(), line.end(), 0.f);
+
+    writeIndex = 0;
+    keepNext = true;
+}
+
+int MultiResolutionAnalyzer::HalfBandDecimator::process(const float* inA, const float* inB, int numSamples, float* outA, float* outB)
+{
+    const float* in[] { inA, inB };
+    float* out[] { outA, outB };
+    const int numSignals = inB != nullptr ? 2 : 1;
+
+    const auto centre = length / 2;
+    const auto numPairs = static_cast<int>(pairCoefficients.size());
+    int numOut = 0;
+
+    for( int i = 0; i < numSamples; ++i )
+    {
+        // in[] has been read up to i before out[] gets written at numOut <= i, which makes it safe in place
+        for( int s = 0; s < numSignals; ++s )
+            lines[s][writeIndex] = lines[s][writeIndex + length] = in[s][i];
+
+        if( keepNext )
+        {
+            for( int s = 0; s < numSignals; ++s )
+            {
+                // the last 'length' samples, oldest first
+                const auto* x = lines[s].data() + writeIndex + 1;
+
+                auto y = centreCoefficient * x[centre];
+                for( int p = 0; p < numPairs; ++p )
+                    y += pairCoefficients[p] * (x[centre - pairOffsets[p]] + x[centre + pairOffsets[p]]);
+
+                out[s][numOut] = y;
+            }
+
+            ++numOut;
+        }
+
+        keepNext = ! keepNext;
+        writeIndex = writeIndex + 1 == length ? 0 : writeIndex + 1;
+    }
+
+    return numOut;
+}
+
+void MultiResolutionAnalyzer::BandHistory::append(const float* a, const float* b, int numSamples)
+{
+    const float* sources[] { a, b };
+    const int numSignals = b != nullptr ? 2 : 1;
+
+    // only the newest Size samples fit anyway
+    if( numSamples > Size )
+    {
+        for( int s = 0; s < numSignals; ++s )
+            sources[s] += numSamples - Size;
+
+        numWritten += numSamples - Size;
+        numSamples = Size;
+    }
+
+    const auto index = static_cast<int>(numWritten & (Size - 1));
+    const auto firstSpan = juce::jmin(numSamples, Size - index);
+
+    for( int s = 0; s < numSignals; ++s )
+    {
+        std::memcpy(samples[s].data() + index, sources[s], sizeof(float) * static_cast<size_t>(firstSpan));
+        std::memcpy(samples[s].data(), sources[s] + firstSpan, sizeof(float) * static_cast<size_t>(numSamples - firstSpan));
+    }
+
+    numWritten += numSamples;
+}
+
+//==============================================================================
+void MultiResolutionAnalyzer::prepare()
+{
+    fft = std::make_unique<juce::dsp::FFT>(BandOrder);
+
+    using Window = juce::dsp::WindowingFunction<float>;
+    const Window::WindowingMethod methods[] { Window::blackmanHarris, Window::hann, Window::flatTop };
+    static_assert(std::size(methods) == std::tuple_size<decltype(windows)>::value, "one table per AnalyzerWindow");
+
+    for( size_t w = 0; w < windows.size(); ++w )
+    {
+        windows[w].resize(BandFFTSize);
+        Window::fillWindowingTables(windows[w].data(), BandFFTSize, methods[w], true);
+    }
+
+    // passes up to 0.2 and stops from 0.3 of the rate going in, which keeps aliasing
+    // out of everything up to 0.4 of the rate coming out. the bands only show up to
+    // 2 * SplitBin / BandFFTSize = 0.375 of it.
+    static_assert(2 * SplitBin * 10 <= 4 * BandFFTSize, "the bands have to stay clear of the aliasing");
+
+    auto design = juce::dsp::FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod(0.1f, -90.f);
+    const std::vector<float> coefficients(design->coefficients.begin(), design->coefficients.end());
+
+    for( auto& decimator : decimators )
+        decimator.prepare(coefficients);
+
+    for( auto& history : histories )
+        for( auto& channel : history.samples )
+            channel.assign(BandHistory::Size, 0.f);
+
+    bands.reserve(MaxNumBands);
+
+    for( auto& frame : frames )
+        frame.assign(static_cast<size_t>(getMaxFrameSize()), 0.f);
+
+    for( auto& channel : windowSamples )
+        channel.assign(BandFFTSize, 0.f);
+
+    timeData.assign(BandFFTSize, {});
+
+    // the frequency only transform works in place, on twice the FFT size
+    realData.assign(2 * BandFFTSize, 0.f);
+    spectrum.assign(BandFFTSize, {});
+}
+
+void MultiResolutionAnalyzer::reset(double sampleRate, const AnalyzerSettings& settings, float newNegativeInfinity)
+{
+    jassert(fft != nullptr);
+
+    numBands = juce::jlimit(2, MaxNumBands, static_cast<int>(settings.order) - BandOrder + 1);
+    windowTable = windows[settings.window].data();
+    mode = settings.mode;
+    calibration = settings.calibration;
+    negativeInfinity = newNegativeInfinity;
+
+    for( auto& decimator : decimators )
+        decimator.reset();
+
+    for( auto& history : histories )
+    {
+        history.numWritten = 0;
+        history.lastWindowEnd = -1;
+    }
+
+    // every band keeps one bin beyond its range on either side, so the columns at the
+    // handover still have a neighbour to interpolate to. what's left over up to the next
+    // band's alignment stays at negative infinity.
+    bands.clear();
+    int offset = 0;
+
+    for( int k = 0; k < numBands; ++k )
+    {
+        const auto isFirst = k == 0;
+        const auto isLast = k == numBands - 1;
+
+        SpectrumBand band;
+        band.binWidth = static_cast<float>(sampleRate / (double(BandFFTSize) * double(1 << k)));
+        band.firstBin = isLast ? 1 : SplitBin - 1;
+        band.numBins = (isFirst ? BandFFTSize / 2 - 1 : 2 * SplitBin + 1) - band.firstBin + 1;
+        band.offset = offset;
+        band.lowestFrequency = isLast ? 0.f : SplitBin * band.binWidth;
+        band.highestFrequency = isFirst ? std::numeric_limits<float>::max() : 2 * SplitBin * band.binWidth;
+
+        offset += roundUpToAlignment(band.numBins);
+        bands.push_back(band);
+    }
+
+    frameSize = offset;
+    jassert(frameSize <= getMaxFrameSize());
+
+    for( auto& frame : frames )
+        std::fill(frame.begin(), frame.end(), negativeInfinity);
+
+    newBands.fill(false);
+}
+
+void MultiResolutionAnalyzer::pushSamples(float* left, float* right, int numSamples)
+{
+    if( mode == AnalyzerMode::MidSide )
+    {
+        for( int i = 0; i < numSamples; ++i )
+        {
+            const auto l = left[i], r = right[i];
+            left[i] = 0.5f * (l + r);
+            right[i] = 0.5f * (l - r);
+        }
+    }
+    else if( mode == AnalyzerMode::MonoSum )
+    {
+        juce::FloatVectorOperations::add(left, right, numSamples);
+        juce::FloatVectorOperations::multiply(left, 0.5f, numSamples);
+    }
+
+    // the mono sum is only the one signal from here on, the decimators and histories leave the second alone
+    auto* second = mode == AnalyzerMode::MonoSum ? nullptr : right;
+
+    histories[0].append(left, second, numSamples);
+
+    for( int k = 1; k < numBands; ++k )
+    {
+        numSamples = decimators[k - 1].process(left, second, numSamples, left, second);
+        histories[k].append(left, second, numSamples);
+    }
+}
+
+bool MultiResolutionAnalyzer::analyze(const AnalyzerSettings& settings)
+{
+    const auto hopSize = settings.getHopSize(BandFFTSize);
+    bool analyzed = false;
+
+    for( int k = 0; k < numBands; ++k )
+    {
+        auto& history = histories[k];
+        newBands[k] = false;
+
+        // the newest window that ends on the band's hop grid, only that one is worth the FFT
+        const auto end = history.numWritten - history.numWritten % hopSize;
+
+        if( end <= history.lastWindowEnd || end < BandFFTSize )
+            continue;
+
+        if( history.lastWindowEnd >= 0 )
+            numDroppedWindows += juce::jmax<juce::int64>(0, (end - history.lastWindowEnd) / hopSize - 1);
+
+        analyzeBand(k, end);
+        history.lastWindowEnd = end;
+        newBands[k] = true;
+        analyzed = true;
+    }
+
+    return analyzed;
+}
+
+void MultiResolutionAnalyzer::analyzeBand(int index, juce::int64 windowEnd)
+{
+    const auto& history = histories[index];
+    const auto& band = bands[index];
+
+    // the history holds the last two windows, the newest hop can't have gone yet
+    jassert(history.numWritten - (windowEnd - BandFFTSize) <= BandHistory::Size);
+
+    const auto start = static_cast<int>((windowEnd - BandFFTSize) & (BandHistory::Size - 1));
+    const auto firstSpan = juce::jmin(BandFFTSize, BandHistory::Size - start);
+    const bool isMono = mode == AnalyzerMode::MonoSum;
+
+    for( int s = 0; s < (isMono ? 1 : 2); ++s )
+    {
+        std::memcpy(windowSamples[s].data(), history.samples[s].data() + start, sizeof(float) * static_cast<size_t>(firstSpan));
+        std::memcpy(windowSamples[s].data() + firstSpan, history.samples[s].data(), sizeof(float) * static_cast<size_t>(BandFFTSize - firstSpan));
+    }
+
+    const auto* a = windowSamples[0].data();
+    const auto* b = windowSamples[1].data();
+
+    auto* first = frames[0].data() + band.offset;
+    auto* second = frames[1].data() + band.offset;
+
+    // the mono sum is one real FFT, and only has the first output
+    if( isMono )
+    {
+        juce::FloatVectorOperations::multiply(realData.data(), a, windowTable, BandFFTSize);
+        fft->performFrequencyOnlyForwardTransform(realData.data());
+        std::memcpy(first, realData.data() + band.firstBin, sizeof(float) * static_cast<size_t>(band.numBins));
+
+        magnitudesToDecibels(first, band.numBins, getScale(index), negativeInfinity);
+        return;
+    }
+
+    for( int i = 0; i < BandFFTSize; ++i )
+        timeData[i] = { a[i] * windowTable[i], b[i] * windowTable[i] };
+
+    fft->perform(timeData.data(), spectrum.data(), false);
+
+    splitTwoRealMagnitudes(spectrum.data(), BandFFTSize, band.firstBin, band.numBins, first, second);
+
+    magnitudesToDecibels(first, band.numBins, getScale(index), negativeInfinity);
+    magnitudesToDecibels(second, band.numBins, getScale(index), negativeInfinity);
+}
+
+float MultiResolutionAnalyzer::getScale(int index) const
+{
+    // the single FFT analyzer's scaling, and the half band filters pass at unity gain,
+    // so a sine reads the same whichever band it lands in. for noise, each band down
+    // gets back the 3 dB its narrower bins lose.
+    auto scale = 2.f / float(BandFFTSize);
+    if( calibration == AnalyzerCalibration::NoiseCalibration )
+        scale *= std::sqrt(float(1 << index));
+
+    return scale;
+}
+
+int MultiResolutionAnalyzer::getHistoryLength() const
+{
+    // the filters' delay on top of the last band's window
+    return (BandFFTSize + decimators[0].length) << (numBands - 1);
+}
+
+int MultiResolutionAnalyzer::getMaxFrameSize()
+{
+    const auto firstBand = BandFFTSize / 2 - SplitBin + 1;
+    const auto middleBand = SplitBin + 3;
+    const auto lastBand = 2 * SplitBin + 1;
+
+    return roundUpToAlignment(firstBand) + (MaxNumBands - 2) * roundUpToAlignment(middleBand) + roundUpToAlignment(lastBand);
+}
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    MultiResolutionAnalyzer.h
+    Created: 17 Oct 2026 9:14:22pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerSettings.h"
+#include "SpectrumBand.h"
+
+/**
+ A constant-Q style analyzer: the same small FFT on a cascade of ever more decimated
+ copies of the signal, instead of one big FFT on the whole band.
+
+ Band 0 is the signal itself, every band after that is the one before run through a
+ half band lowpass and decimated by 2. Every band has BandFFTSize point windows, so each
+ one has twice the frequency resolution (and half the update rate) of the band above it.
+ Each band only shows the octave or so between SplitBin and 2 * SplitBin of its own FFT,
+ which is well inside what the half band filter keeps free of aliasing. Band 0 goes on
+ up to Nyquist, the last band on down to DC.
+
+ The settings' FFT order sets the resolution of that last band: order 14 gives five bands
+ and 16384 point resolution below 1.1 kHz at 48 kHz, for five 1024 point FFTs.
+
+ Every band is scaled like one FFT of the full signal would be, so a sine reads its
+ peak level in whichever band it lands. Each band's bins are half as wide as the band
+ above's though, so a bin catches half the power of broadband noise, and noise reads
+ 3 dB lower with every band down: a staircase at the handovers. The settings' calibration
+ can add those 3 dB per band back instead, which makes white noise read flat, and
+ sines read 3 dB higher per band down. Neither is right for both.
+
+ Both analyzer channels share one complex FFT per band, the same way the benchmarks'
+ single FFT FFTDataGenerator does it. The mono sum is only one signal all the way down,
+ through one set of decimators and one real FFT per band, and only fills frame 0. The decibel values of all bands go into one frame per output, laid out as
+ getBands() says, and the AnalyzerPathGenerator stitches them together per pixel column.
+ Each band starts on a multiple of BandAlignment values, so the SpectrumAverager can
+ average any one of them with whole SIMD registers without touching its neighbours.
+ */
+struct MultiResolutionAnalyzer
+{
+    static constexpr int NumOutputs = 2;
+
+    static constexpr int BandOrder = 10;
+    static constexpr int BandFFTSize = 1 << BandOrder;
+    static constexpr int MaxNumBands = FFTOrder::order32768 - BandOrder + 1;
+
+    // where the bands hand over, in bins of their own FFT
+    static constexpr int SplitBin = BandFFTSize * 3 / 16;
+
+    // where the bands can start in the frames, in values. a multiple of any SIMD register's width.
+    static constexpr int BandAlignment = 16;
+
+    /** allocates for the most bands there can be, so do this before the first reset(). */
+    void prepare();
+
+    /** starts over with the number of bands, window and mode from the settings. */
+    void reset(double sampleRate, const AnalyzerSettings& settings, float negativeInfinity);
+
+    /**
+     feeds in the next samples of both channels. they get turned into the signals
+     the mode asks for and decimated in place, so both arrays get overwritten
+     (only 'left' for the mono sum, which it holds from then on).
+     */
+    void pushSamples(float* left, float* right, int numSamples);
+
+    /**
+     transforms every band whose newest window has moved on by a hop (in the band's
+     own samples) since the last time. returns true if that changed the frames.
+     */
+    bool analyze(const AnalyzerSettings& settings);
+
+    /** which bands the last analyze() transformed, one flag per band in getBands(). */
+    const bool* getNewBands() const { return newBands.data(); }
+
+    /** the stitched decibel values of one output, padded out to BandAlignment after every band. */
+    const std::vector<float>& getFrame(int output) const { return frames[output]; }
+    int getFrameSize() const { return frameSize; }
+    const std::vector<SpectrumBand>& getBands() const { return bands; }
+
+    /** how many input samples it takes to fill the last band's window, from scratch. */
+    int getHistoryLength() const;
+
+    /** hops that were skipped, over all bands, because a newer one was ready by the time analyze() came round. */
+    juce::int64 getNumDroppedWindows() const { return numDroppedWindows; }
+
+    static int getMaxFrameSize();
+private:
+    /** a half band lowpass that keeps every second sample, of two signals at once. */
+    struct HalfBandDecimator
+    {
+        void prepare(const std::vector<float>& coefficients);
+        void reset();
+
+        /** out[] may be in[]. returns the number of samples written. */
+        int process(const float* inA, const float* inB, int numSamples, float* outA, float* outB);
+
+        // the taps either side of the centre that aren't 0, only every second one is in a half band filter
+        std::vector<float> pairCoefficients;
+        std::vector<int> pairOffsets;
+        float centreCoefficient { 0.5f };
+        int length { 0 };
+
+        // the last 'length' samples, twice over so they're always in one piece
+        std::array<std::vector<float>, 2> lines;
+        int writeIndex { 0 };
+        bool keepNext { true };
+    };
+
+    /** the newest decimated samples of one band, and where its last window ended. */
+    struct BandHistory
+    {
+        static constexpr int Size = 2 * BandFFTSize;
+
+        void append(const float* a, const float* b, int numSamples);
+
+        std::array<std::vector<float>, 2> samples;
+        juce::int64 numWritten { 0 };
+        juce::int64 lastWindowEnd { -1 };
+    };
+
+    void analyzeBand(int band, juce::int64 windowEnd);
+
+    /** what a band's magnitudes get multiplied by, for the calibration. */
+    float getScale(int band) const;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::array<std::vector<float>, 3> windows;
+    const float* windowTable { nullptr };
+
+    std::array<HalfBandDecimator, MaxNumBands - 1> decimators;
+    std::array<BandHistory, MaxNumBands> histories;
+
+    int numBands { 0 };
+    AnalyzerMode mode { AnalyzerMode::LeftRight };
+    AnalyzerCalibration calibration { AnalyzerCalibration::SineCalibration };
+    float negativeInfinity { -48.f };
+
+    std::vector<SpectrumBand> bands;
+    std::array<bool, MaxNumBands> newBands {};
+    std::array<std::vector<float>, NumOutputs> frames;
+    int frameSize { 0 };
+
+    std::array<std::vector<float>, 2> windowSamples;
+    std::vector<juce::dsp::Complex<float>> timeData, spectrum;
+    std::vector<float> realData;
+
+    juce::int64 numDroppedWindows { 0 };
+};
@@ -10,58 +10,182 @@
 
 #include "PathProducer.h"
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+void PathProducer::prepare()
 {
-    juce::AudioBuffer<float> tempIncomningBuffer;
+    analyzer.prepare();
     
-    while(leftChannelFifo->getNumCompleteBuffersAvailable() > 0 )
+    for( auto& block : blocks )
+        block.assign(BlockSize, 0.f);
+    
+    for( auto& averager : averagers )
+        averager.prepare(MultiResolutionAnalyzer::getMaxFrameSize(), MultiResolutionAnalyzer::MaxNumBands);
+    
+    // the first process() sets the analyzer up for its sample rate
+    analyzedSampleRate = 0.0;
+}
+
+void PathProducer::restart(double sampleRate, const AnalyzerSettings& settings)
+{
+    analyzedSettings = settings;
+    analyzedSampleRate = sampleRate;
+    
+    analyzer.reset(sampleRate, settings, negativeInfinity);
+    
+    for( auto& averager : averagers )
+        averager.setBands(analyzer.getBands());
+    
+    spectrogram.reset();
+    
+    readPosition = -1;
+    samplesSinceLastFrame = 0;
+}
+
+void PathProducer::process(juce::Rectangle<float> fftBounds, float scale, double sampleRate, const AnalyzerSettings& settings)
+{
+    if( sampleRate <= 0.0 )
+        return;
+    
+    const auto mode = settings.mode;
+    
+    if( settings.order != analyzedSettings.order
+       || settings.window != analyzedSettings.window
+       || settings.calibration != analyzedSettings.calibration
+       || mode != analyzedSettings.mode
+       || sampleRate != analyzedSampleRate )
     {
-        if(leftChannelFifo->getAudioBuffer(tempIncomningBuffer))
+        // a different resolution, window or signal, averaging it with the old one makes no sense
+        restart(sampleRate, settings);
+        
+        // the mono sum only has one trace, so the second one has to go
+        if( mode == AnalyzerMode::MonoSum )
         {
-            auto size = tempIncomningBuffer.getNumSamples();
-            
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, 0),
-                                              monoBuffer.getReadPointer(0, size),
-                                              monoBuffer.getNumSamples() - size);
-            
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                                              tempIncomningBuffer.getReadPointer(0, 0),
-                                              size);
+            paths[1].getWriteSlot().clear();
+            paths[1].publish();
             
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, -48.f);
-             
-
-            const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
-            
-            const auto binWidth = sampleRate / (double) fftSize;
-
-            while( leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
-            {
-                std::vector<float> ftdData;
-                if(leftChannelFFTDataGenerator.getFFTData(ftdData))
-                {
-                    pathProducer.generatePath(ftdData, fftBounds, fftSize, binWidth, -48.f);
-                    
-                }
-            }
+            peakPaths[1].getWriteSlot().clear();
+            peakPaths[1].publish();
         }
     }
     
-    const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
+    // the spectrogram shows the raw frames, so the averages went stale in the meantime
+    if( settings.view != processedView )
+    {
+        processedView = settings.view;
+        
+        for( auto& averager : averagers )
+            averager.reset();
+        
+        // and the spectrogram's history starts over from an empty image
+        spectrogram.reset();
+    }
+    
+    // only what both taps have
+    auto newest = juce::jmin(leftChannelFifo->getWritePosition(), rightChannelFifo->getWritePosition());
+    
+    // the taps start over from 0 after prepareToPlay
+    if( newest < readPosition )
+        restart(sampleRate, settings);
     
-    const auto binWidth = sampleRate / (double) fftSize;
+    // from scratch, go back far enough to fill every band's window straight away.
+    // that history is from before the spectrogram's time starts, it doesn't get rows.
+    const bool fromScratch = readPosition < 0;
+    if( fromScratch )
+        readPosition = juce::jmax<juce::int64>(0, newest - analyzer.getHistoryLength());
     
-    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+    juce::int64 numSamplesRead = 0;
+    
+    while( readPosition < newest )
+    {
+        const auto numSamples = static_cast<int>(juce::jmin<juce::int64>(BlockSize, newest - readPosition));
+        
+        // false if the audio thread lapped us while copying, then the next call starts over
+        if( ! leftChannelFifo->read(blocks[0].data(), readPosition, numSamples)
+           || ! rightChannelFifo->read(blocks[1].data(), readPosition, numSamples) )
+        {
+            restart(sampleRate, settings);
+            return;
+        }
+        
+        analyzer.pushSamples(blocks[0].data(), blocks[1].data(), numSamples);
+        
+        readPosition += numSamples;
+        numSamplesRead += numSamples;
+        samplesSinceLastFrame += numSamples;
+    }
+    
+    if( analyzer.analyze(settings) )
     {
-        std::vector<float> fftData;
-        if(leftChannelFFTDataGenerator.getFFTData(fftData))
+        const auto secondsSinceLastFrame = static_cast<float>(samplesSinceLastFrame / sampleRate);
+        samplesSinceLastFrame = 0;
+        
+        if( settings.view == AnalyzerView::SpectrogramView )
         {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, -48.f);
+            // the louder of the two traces, the rows go by the samples below
+            spectrogram.addFrame(analyzer.getFrame(0).data(),
+                                 mode == AnalyzerMode::MonoSum ? nullptr : analyzer.getFrame(1).data(),
+                                 analyzer.getBands(),
+                                 juce::roundToInt(fftBounds.getWidth() * scale),
+                                 negativeInfinity);
         }
+        else
+        {
+            for( int i = 0; i < NumPaths; ++i )
+            {
+                if( mode == AnalyzerMode::MonoSum && i == 1 )
+                    continue;
+                
+                // only the bands that were due go into the averages, the rest keep what they had
+                auto& averager = averagers[i];
+                averager.process(analyzer.getFrame(i).data(), analyzer.getNewBands(), settings, secondsSinceLastFrame);
+                pathGenerators[i].generatePath(averager.getAverage(), fftBounds, analyzer.getBands(), negativeInfinity);
+                
+                if( settings.peakHold )
+                    peakPathGenerators[i].generatePath(averager.getPeaks(), fftBounds, analyzer.getBands(), negativeInfinity);
+            }
+        }
+    }
+    
+    // a row for every 1 / RowsPerSecond of audio, whether or not a band had a new frame in it
+    if( settings.view == AnalyzerView::SpectrogramView && ! fromScratch )
+        spectrogram.advance(static_cast<int>(numSamplesRead), sampleRate);
+    
+    // the held peaks go with the line view, and go away with peak hold
+    const auto showPeaks = settings.peakHold && settings.view == AnalyzerView::LineView;
+    if( showingPeaks && ! showPeaks )
+        clearPeakPaths();
+    
+    showingPeaks = showPeaks;
+    
+    for( int i = 0; i < NumPaths; ++i )
+    {
+        publishNewest(pathGenerators[i], paths[i]);
+        publishNewest(peakPathGenerators[i], peakPaths[i]);
+    }
+}
+
+void PathProducer::publishNewest(AnalyzerPathGenerator<juce::Path>& pathGenerator, TripleBuffer<juce::Path>& path)
+{
+    // only the newest path is worth handing over
+    bool gotPath = false;
+    while (pathGenerator.getNumPathsAvailable() > 0)
+    {
+        gotPath = pathGenerator.getPath(path.getWriteSlot()) || gotPath;
     }
     
-    while (pathProducer.getNumPathsAvailable() > 0)
+    if( gotPath )
+        path.publish();
+}
+
+void PathProducer::clearPeakPaths()
+{
+    juce::Path stale;
+    for( int i = 0; i < NumPaths; ++i )
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        // whatever the generator still has queued is older than this
+        while( peakPathGenerators[i].getNumPathsAvailable() > 0 )
+            peakPathGenerators[i].getPath(stale);
+        
+        peakPaths[i].getWriteSlot().clear();
+        peakPaths[i].publish();
     }
 }
@@ -11,32 +11,118 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "FFTDataGenerator.h"
+#include "MultiResolutionAnalyzer.h"
 #include "AnalyzerPathGenerator.h"
+#include "AnalyzerSettings.h"
+#include "SpectrumAverager.h"
+#include "Spectrogram.h"
 #include "../PluginProcessor.h"
+#include "../DSP/TripleBuffer.h"
 
+/**
+ Turns the left and right analyzer taps into two paths, and with peak hold on, two more
+ for their held peaks, drawn over them.
+ Path 0 is left (or mid, or the mono sum), path 1 right (or side, empty for the mono sum).
+ In the spectrogram view it turns the frames into SpectrogramRows instead, at
+ SpectrogramGenerator::RowsPerSecond rows per second of audio read.
+ 
+ Every call to process() streams whatever the taps got since the last one through the
+ MultiResolutionAnalyzer, which transforms each of its bands at most once per call, on
+ the band's own hop grid. Whatever the host's block size, that's at most one FFT per
+ band per display refresh.
+ process() runs on the AnalyzerThread, pullLatestPaths() and getPath() on whichever thread draws the paths,
+ getSpectrogramRow() on whichever thread draws the spectrogram.
+ */
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>& scsf) :
-    leftChannelFifo(&scsf)
+    using SampleFifo = SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>;
+    static constexpr int NumPaths = MultiResolutionAnalyzer::NumOutputs;
+    
+    // how many samples at a time get copied out of the taps
+    static constexpr int BlockSize = 1024;
+    
+    PathProducer(SampleFifo& left, SampleFifo& right) :
+    leftChannelFifo(&left),
+    rightChannelFifo(&right)
+    {
+        static_assert(2 * (MultiResolutionAnalyzer::BandFFTSize << (MultiResolutionAnalyzer::MaxNumBands - 1)) <= SampleFifo::Capacity,
+                      "the taps have to hold the history the analyzer starts from");
+    }
+    
+    /**
+     allocates everything the analyzer, the averagers and the copies out of the taps need.
+     call it on the thread that calls process(), before the first time.
+     after this, changing the analyzer settings never allocates.
+     */
+    void prepare();
+    
+    /** the spectrogram rows get a pixel per physical pixel of fftBounds, 'scale' is how many there are per unit. */
+    void process(juce::Rectangle<float> fftBounds, float scale, double sampleRate, const AnalyzerSettings& settings);
+    
+    /** swaps in the newest finished paths. returns false if none changed since the last call. */
+    bool pullLatestPaths()
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order2048);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+        bool gotPath = false;
+        for( auto& path : paths )
+            gotPath = path.acquireLatest() || gotPath;
+        
+        for( auto& path : peakPaths )
+            gotPath = path.acquireLatest() || gotPath;
+        
+        return gotPath;
     }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    
+    /** the paths as of the last pullLatestPaths(). */
+    const juce::Path& getPath(int index) const { return paths[index].getReadSlot(); }
+    
+    /** the held peaks of getPath(index), empty while peak hold is off. */
+    const juce::Path& getPeakPath(int index) const { return peakPaths[index].getReadSlot(); }
+    
+    /** swaps the oldest spectrogram row into 'row'. false if there are no more. */
+    bool getSpectrogramRow(SpectrogramRow& row) { return spectrogram.getRow(row); }
     
     void updateNegativeInfinity(float nf) { negativeInfinity = nf; }
+    
+    /** hops that were skipped because a newer one was ready by the time process() came round. */
+    juce::int64 getNumDroppedWindows() const { return analyzer.getNumDroppedWindows(); }
 private:
-    SingleChannelSampleFifo<SimpleEQAudioProcessor::BlockType>* leftChannelFifo;
+    /** forgets everything so far, the next process() picks up from the newest samples. */
+    void restart(double sampleRate, const AnalyzerSettings& settings);
+    
+    /** hands the newest path 'pathGenerator' has made over to 'path', if it made one. */
+    static void publishNewest(AnalyzerPathGenerator<juce::Path>& pathGenerator, TripleBuffer<juce::Path>& path);
+    
+    /** empties the peak paths, once peak hold is switched off. */
+    void clearPeakPaths();
+    
+    SampleFifo* leftChannelFifo;
+    SampleFifo* rightChannelFifo;
+    
+    // how far the analyzer has read the taps, -1 to start over from the newest samples
+    juce::int64 readPosition { -1 };
+    juce::int64 samplesSinceLastFrame { 0 };
+    
+    // what the analyzer was last reset for
+    AnalyzerSettings analyzedSettings;
+    double analyzedSampleRate { 0.0 };
+    
+    MultiResolutionAnalyzer analyzer;
+    std::array<std::vector<float>, NumPaths> blocks;
+    
+    std::array<SpectrumAverager, NumPaths> averagers;
+    
+    std::array<AnalyzerPathGenerator<juce::Path>, NumPaths> pathGenerators;
     
-    juce::AudioBuffer<float> monoBuffer;
+    std::array<TripleBuffer<juce::Path>, NumPaths> paths;
     
-    FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    std::array<AnalyzerPathGenerator<juce::Path>, NumPaths> peakPathGenerators;
+    std::array<TripleBuffer<juce::Path>, NumPaths> peakPaths;
+    bool showingPeaks { false };
     
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    SpectrogramGenerator spectrogram;
     
-    juce::Path leftChannelFFTPath;
+    // the averagers start over when the line view comes back
+    AnalyzerView processedView { AnalyzerView::LineView };
     
     float negativeInfinity { -48.f };
 };
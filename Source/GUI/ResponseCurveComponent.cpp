@@ -14,17 +14,21 @@
 
 ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p) :
 audioProcessor(p),
-leftPathProducer(audioProcessor.leftChannelFifo),
-rightPathProducer(audioProcessor.rightChannelFifo)
+analyzerThread(audioProcessor)
 {
     const auto& params = audioProcessor.getParameters();
     for (auto param : params) {
-        param->addListener(this);
+        auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param);
+        parameterBands.push_back(withID != nullptr ? getBandForParameter(withID->paramID) : -1);
     }
     
-    updateChain();
+    // only once the table is complete, the callbacks can come from the audio thread
+    for (auto param : params) {
+        param->addListener(this);
+    }
     
-    startTimerHz(60);
+    // paint() covers every pixel, so nothing behind needs repainting with it
+    setOpaque(true);
 }
 
 ResponseCurveComponent::~ResponseCurveComponent()
@@ -37,153 +41,180 @@ ResponseCurveComponent::~ResponseCurveComponent()
 
 void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
 {
+    // this can be called from the audio thread during automation, so only flag it
+    auto band = parameterBands[parameterIndex];
+    if( band < 0 )
+        return;
+    
+    ++parameterVersions[band];
     parametersChanged = true;
 }
 
 
 
-void ResponseCurveComponent::timerCallback()
+void ResponseCurveComponent::onVBlank()
 {
-    if(shouldShowFFTAnalysis)
+    // the new curve shows up in one of the next images
+    if(parametersChanged.compareAndSetBool(false, true) || audioProcessor.getSampleRate() != curveSampleRate)
     {
-        auto fftBounds = getAnalysisArea().toFloat();
-        auto sampleRate = audioProcessor.getSampleRate();
-    
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        updateResponseCurve();
     }
     
-    if(parametersChanged.compareAndSetBool(false, true))
+    if(shouldShowFFTAnalysis)
+        analyzerThread.requestImage();
+    
+    auto analysisArea = getAnalysisArea();
+    bool analysisChanged = false;
+    
+    const auto view = static_cast<AnalyzerView>(audioProcessor.apvts.getRawParameterValue("Analyzer View")->load());
+    const bool showSpectrogram = shouldShowFFTAnalysis && view == AnalyzerView::SpectrogramView;
+    if(showSpectrogram != shouldShowSpectrogram)
     {
-        updateChain();
+        shouldShowSpectrogram = showSpectrogram;
+        spectrogram.clear();
+        analysisChanged = true;
     }
-    repaint();
-}
-
-void ResponseCurveComponent::updateChain()
-{
-    auto chainSettings = getChainSettings(audioProcessor.apvts);
-    
-    monoChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    monoChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    monoChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
     
-    auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCoefficients(monoChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    // a row per 1 / RowsPerSecond of audio, each one only overwrites the oldest row of the history.
+    // they get drained either way, so none are left over for the next time the view is on.
+    while(analyzerThread.pullSpectrogramRow(spectrogramRow))
+    {
+        if(shouldShowSpectrogram)
+        {
+            spectrogram.addRow(spectrogramRow);
+            analysisChanged = true;
+        }
+    }
     
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
+    // the analyzer and the curve are rendered on the AnalyzerThread, this only swaps the image in.
+    // it only covers the analysis area, the rest never changes.
+    if(analyzerThread.pullLatestImage())
+        analysisChanged = true;
     
-    updateCutFilter(monoChain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(monoChain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+    if(analysisChanged)
+        repaint(analysisArea);
 }
 
-void ResponseCurveComponent::paint (juce::Graphics& g)
+//==============================================================================
+void ResponseCurveComponent::updateResponseCurve()
 {
     using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (ColorScheme::getAnalyzerBackgroundColor());
-    
-    g.drawImage(background, getLocalBounds().toFloat());
     
     auto responseArea = getAnalysisArea();
-    auto w = responseArea.getWidth();
+    const auto w = responseArea.getWidth();
+    const auto sampleRate = audioProcessor.getSampleRate();
     
-    auto& lowcut = monoChain.get<ChainPositions::LowCut>();
-    auto& peak = monoChain.get<ChainPositions::Peak>();
-    auto& highcut = monoChain.get<ChainPositions::HighCut>();
+    // a new width or sample rate moves every band, otherwise only the ones whose parameters did
+    const bool updateAllBands = responseEngine.getNumFrequencies() != w || sampleRate != curveSampleRate;
+    curveSampleRate = sampleRate;
     
-    auto samplerate = audioProcessor.getSampleRate();
+    if( w <= 0 || sampleRate <= 0 )
+    {
+        responseCurve.clear();
+        analyzerThread.setResponseCurve(responseCurve);
+        return;
+    }
     
-    std::vector<double> mags;
-    mags.resize(w);
+    if( updateAllBands )
+    {
+        responseEngine.setLogFrequencies(w, MIN_FREQUENCY, MAX_FREQUENCY, sampleRate);
+        filterCoefficients.sampleRate = sampleRate;
+    }
     
-    for (int i = 0; i < w; ++i) {
-        double mag = 1.f;
-        auto freq = mapToLog10(double(i) / double(w), double(MIN_FREQUENCY), double(MAX_FREQUENCY));
+    for( int i = 0; i < NumChainPositions; ++i )
+    {
+        const auto band = static_cast<ChainPositions>(i);
         
-        if(!monoChain.isBypassed<ChainPositions::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, samplerate);
+        // read the version before the parameters, a change that lands in between gets picked up next time
+        const auto version = parameterVersions[i].load();
+        if( version == computedVersions[i] && ! updateAllBands )
+            continue;
         
+        computedVersions[i] = version;
         
-        if(!monoChain.isBypassed<ChainPositions::LowCut>())
-        {
-            if(!lowcut.isBypassed<0>())
-                mag *= lowcut.get<0>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!lowcut.isBypassed<1>())
-                mag *= lowcut.get<1>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!lowcut.isBypassed<2>())
-                mag *= lowcut.get<2>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!lowcut.isBypassed<3>())
-                mag *= lowcut.get<3>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-        }
-        if(!monoChain.isBypassed<ChainPositions::HighCut>())
+        // designed the same way the CoefficientDesigner does it for the audio thread
+        switch( band )
         {
-            if(!highcut.isBypassed<0>())
-                mag *= highcut.get<0>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!highcut.isBypassed<1>())
-                mag *= highcut.get<1>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!highcut.isBypassed<2>())
-                mag *= highcut.get<2>().coefficients->getMagnitudeForFrequency(freq, samplerate);
-            if(!highcut.isBypassed<3>())
-                mag *= highcut.get<3>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+            case ChainPositions::LowCut:
+                getLowCutSettings(audioProcessor.apvts, chainSettings);
+                designLowCut(filterCoefficients.lowCut, chainSettings, sampleRate);
+                break;
+            case ChainPositions::Peak:
+                getPeakSettings(audioProcessor.apvts, chainSettings);
+                designPeak(filterCoefficients, chainSettings, sampleRate);
+                break;
+            case ChainPositions::HighCut:
+                getHighCutSettings(audioProcessor.apvts, chainSettings);
+                designHighCut(filterCoefficients.highCut, chainSettings, sampleRate);
+                break;
+            default:
+                jassertfalse;
+                break;
         }
         
-        mags[i] = Decibels::gainToDecibels(mag);
+        responseEngine.process(filterCoefficients, band, bandResponses[i]);
     }
     
-    Path responseCurve;
-
     const double outputMin = responseArea.getBottom();
     const double outputMax = responseArea.getY();
     auto map = [outputMin, outputMax](double input)
     {
         return jmap(input, double(MIN_GAIN), double(MAX_GAIN), outputMin, outputMax);
-        
     };
     
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
+    // the chain's decibels, as long as no band is floored. one that is drags the sum below MIN_GAIN anyway
+    auto getMagnitude = [this](size_t i)
+    {
+        return double(bandResponses[ChainPositions::LowCut].magnitudeInDecibels[i])
+             + double(bandResponses[ChainPositions::Peak].magnitudeInDecibels[i])
+             + double(bandResponses[ChainPositions::HighCut].magnitudeInDecibels[i]);
+    };
     
-    for (size_t i = 1; i < mags.size(); ++i) {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
-    }
+    responseCurve.clear();
+    responseCurve.preallocateSpace(3 * w);
+    responseCurve.startNewSubPath(responseArea.getX(), map(getMagnitude(0)));
     
-    if(shouldShowFFTAnalysis)
-    {
-        drawFFTAnalysis(g, responseArea);
+    for (int i = 1; i < w; ++i) {
+        responseCurve.lineTo(responseArea.getX() + i, map(getMagnitude(static_cast<size_t>(i))));
     }
     
-    g.setColour(ColorScheme::getModuleBorderColor());
-    g.drawRoundedRectangle(getRenderArea().toFloat(), 4.f, 1.f);
-    g.setColour(ColorScheme::getFFTLineColor());
-    g.strokePath(responseCurve, PathStrokeType(2.f));
+    analyzerThread.setResponseCurve(responseCurve);
 }
 
-void ResponseCurveComponent::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds)
+void ResponseCurveComponent::paint (juce::Graphics& g)
 {
     using namespace juce;
-    auto responseArea = getAnalysisArea();
-    
-    auto leftChannelFFTPath = leftPathProducer.getPath();
+    // the background covers the whole component, so it's opaque without filling it first.
+    // it's the component's size, so it goes on unscaled, and only the clipped part of it at that.
+    g.drawImageAt(background, 0, 0);
     
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
-    
-    g.setColour(ColorScheme::getLeftOutputSignalColor());
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1));
-    
-    auto rightChannelFFTPath = rightPathProducer.getPath();
+    // moving to a display with a different scale re-renders the analysis image at the new one
+    const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if( scale != renderScale )
+    {
+        renderScale = scale;
+        analyzerThread.setAnalysisBounds(getAnalysisArea().toFloat(), renderScale);
+    }
     
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), responseArea.getY()));
+    // under the curve, it has nothing to do with the image
+    if( shouldShowSpectrogram )
+        spectrogram.draw(g, getAnalysisArea().toFloat());
     
-    g.setColour(ColorScheme::getRightOutputSignalColor());
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1));
+    // the analyzer and the response curve, rasterized on the AnalyzerThread at the display's scale
+    const auto& analysis = analyzerThread.getImage();
+    if( analysis.image.isValid() )
+        g.drawImage(analysis.image, analysis.bounds);
     
+    g.setColour(ColorScheme::getModuleBorderColor());
+    g.drawRoundedRectangle(getRenderArea().toFloat(), 4.f, 1.f);
 }
 
 void ResponseCurveComponent::resized()
 {
     using namespace juce;
     background = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
+    
+    analyzerThread.setAnalysisBounds(getAnalysisArea().toFloat(), renderScale);
 
     Graphics g(background);
 
@@ -192,6 +223,8 @@ void ResponseCurveComponent::resized()
     drawBackgroundGrid(g, bounds);
     
     drawTextLabels(g, bounds);
+    
+    updateResponseCurve();
 }
 
 void ResponseCurveComponent::drawBackgroundGrid(juce::Graphics &g,
@@ -11,12 +11,21 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "PathProducer.h"
+#include "AnalyzerThread.h"
 #include "../PluginProcessor.h"
+#include "../DSP/FrequencyResponse.h"
 
+/**
+ Draws the response curve over the analyzer. Nothing runs on a timer: once per display
+ refresh, the vblank callback wakes the AnalyzerThread up, and only repaints the analysis
+ area if the AnalyzerThread rendered a new image of it since the last one.
+ That happens when new analyzer paths arrive or a parameter moves the curve,
+ so an idle editor costs next to nothing, and paint() is a blit of the background and that image.
+ In the spectrogram view the vblank also writes the new rows into the SpectrogramImage,
+ and paint() blits that under the curve.
+ */
 struct ResponseCurveComponent: juce::Component,
-juce::AudioProcessorParameter::Listener,
-juce::Timer
+juce::AudioProcessorParameter::Listener
 {
     ResponseCurveComponent(SimpleEQAudioProcessor&);
     ~ResponseCurveComponent();
@@ -25,14 +34,13 @@ juce::Timer
 
     void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override { }
     
-    void timerCallback() override;
-    
     void paint(juce::Graphics& g) override;
     void resized() override;
     
     void toggleAnalysisEnablement(bool enabled)
     {
         shouldShowFFTAnalysis = enabled;
+        analyzerThread.setEnabled(enabled);
     }
 
     
@@ -41,9 +49,34 @@ private:
     SimpleEQAudioProcessor& audioProcessor;
     juce::Atomic<bool> parametersChanged { false };
     
-    MonoChain monoChain;
+    // the band every parameter belongs to, by index, -1 for the ones that don't move the curve
+    std::vector<int> parameterBands;
+    
+    // every band has its own parameter version, so moving one only recomputes that band
+    std::array<std::atomic<juce::uint32>, NumChainPositions> parameterVersions {};
+    std::array<juce::uint32, NumChainPositions> computedVersions {};
+    
+    ChainSettings chainSettings;
+    FilterCoefficients filterCoefficients;
+    
+    // one frequency per pixel column
+    FrequencyResponseEngine responseEngine;
+    
+    // each band's response, and the curve of their decibels added up. every band is floored at
+    // FrequencyResponseEngine::MinusInfinityDb, so where one is down there the sum reads higher
+    // than the chain's own response, but still far below MIN_GAIN, off the graph either way.
+    // the curve gets rendered on the AnalyzerThread.
+    std::array<FrequencyResponse, NumChainPositions> bandResponses;
+    juce::Path responseCurve;
     
-    void updateChain();
+    // what the cached bands were computed for
+    double curveSampleRate { 0 };
+    
+    /** recomputes the bands that changed, rebuilds the curve and hands it to the AnalyzerThread. message thread only. */
+    void updateResponseCurve();
+    
+    /** picks up whatever changed since the last display refresh and repaints if anything did. */
+    void onVBlank();
     
     juce::Image background;
     
@@ -61,10 +94,19 @@ private:
     
     void drawBackgroundGrid(juce::Graphics &g, juce::Rectangle<int> bounds);
     
-    void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
+    AnalyzerThread analyzerThread;
     
-    PathProducer leftPathProducer, rightPathProducer;
+    // the physical pixels per unit paint() last saw, the analysis image gets rendered at that
+    float renderScale { 1.f };
     
     bool shouldShowFFTAnalysis = true;
+    
+    // the history, and the row the AnalyzerThread's rows get swapped into
+    SpectrogramImage spectrogram;
+    SpectrogramRow spectrogramRow;
+    bool shouldShowSpectrogram = false;
+    
+    // last, so it goes before anything its callback uses
+    juce::VBlankAttachment vblankAttachment { this, [this] { onVBlank(); } };
 };
 
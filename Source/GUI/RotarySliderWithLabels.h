@@ -21,7 +21,7 @@ struct RotarySliderWithLabels : juce::Slider
     param(&rap),
     suffix(unitSuffix)
     {
-        setLookAndFeel(&lnf);
+        setLookAndFeel(lnf.get());
     }
     
 ~RotarySliderWithLabels()
@@ -42,7 +42,8 @@ struct RotarySliderWithLabels : juce::Slider
     int getTextHeight() const { return 14; }
     juce::String getDisplayString() const;
 private:
-    LookAndFeel lnf;
+    // one for every slider, so they share its sprites
+    juce::SharedResourcePointer<LookAndFeel> lnf;
     
     juce::RangedAudioParameter* param;
     juce::String suffix;
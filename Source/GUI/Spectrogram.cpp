@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    Spectrogram.cpp
+    Created: 17 Oct 2026 11:36:05pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "Spectrogram.h"
+#include "LookAndFeel.h"
+
+SpectrogramGenerator::SpectrogramGenerator()
+{
+    ColorScheme::getSpectrogramGradient().createLookupTable(colours.data(), NumColours);
+}
+
+void SpectrogramGenerator::addFrame(const float* first,
+                                    const float* second,
+                                    const std::vector<SpectrumBand>& bands,
+                                    int width,
+                                    float negativeInfinity)
+{
+    if( width <= 0 || bands.empty() )
+        return;
+
+    columns.update(bands, width);
+
+    if( static_cast<int>(pending.size()) != width )
+    {
+        pending.resize(static_cast<size_t>(width));
+        rowHasFrames = false;
+    }
+
+    pendingNegativeInfinity = negativeInfinity;
+
+    for( int x = 0; x < width; ++x )
+    {
+        auto v = columns.getValue(first, x);
+        if( second != nullptr )
+            v = juce::jmax(v, columns.getValue(second, x));
+
+        auto& p = pending[static_cast<size_t>(x)];
+        p = rowHasFrames ? juce::jmax(p, v) : v;
+    }
+
+    hasPending = true;
+    rowHasFrames = true;
+}
+
+void SpectrogramGenerator::advance(int numSamples, double sampleRate)
+{
+    if( sampleRate <= 0.0 )
+        return;
+
+    const auto samplesPerRow = sampleRate / RowsPerSecond;
+    samplesSinceLastRow += numSamples;
+
+    // after a long gap, more than the whole history is the same as the whole history
+    if( samplesSinceLastRow > NumRows * samplesPerRow )
+        samplesSinceLastRow = NumRows * samplesPerRow;
+
+    while( samplesSinceLastRow >= samplesPerRow )
+    {
+        samplesSinceLastRow -= samplesPerRow;
+
+        // nothing to show before the first frame, but the time still goes by
+        if( hasPending )
+            pushRow();
+
+        rowHasFrames = false;
+    }
+}
+
+void SpectrogramGenerator::reset()
+{
+    hasPending = false;
+    rowHasFrames = false;
+    samplesSinceLastRow = 0.0;
+}
+
+void SpectrogramGenerator::pushRow()
+{
+    auto* slot = rowFifo.acquireWrite();
+    if( slot == nullptr )
+        return;
+
+    auto& row = *slot;
+    row.resize(pending.size());
+
+    // negative infinity is the first colour, 0 dB the last
+    const auto toIndex = float(NumColours - 1) / -pendingNegativeInfinity;
+
+    for( size_t x = 0; x < pending.size(); ++x )
+    {
+        const auto index = juce::jlimit(0, NumColours - 1, juce::roundToInt((pending[x] - pendingNegativeInfinity) * toIndex));
+        row[x] = colours[static_cast<size_t>(index)];
+    }
+
+    rowFifo.commitWrite();
+}
+
+//==============================================================================
+void SpectrogramImage::addRow(const SpectrogramRow& row)
+{
+    using namespace juce;
+
+    const auto width = static_cast<int>(row.size());
+    const auto height = SpectrogramGenerator::NumRows;
+    if( width <= 0 )
+        return;
+
+    // transparent until the history fills up, so the grid shows through
+    if( image.getWidth() != width || image.getHeight() != height )
+    {
+        image = Image(Image::PixelFormat::ARGB, width, height, true, SoftwareImageType());
+        newestRow = 0;
+    }
+
+    // one up, wrapping round to the bottom, which is where the oldest row is
+    newestRow = (newestRow + height - 1) % height;
+
+    Image::BitmapData data(image, 0, newestRow, width, 1, Image::BitmapData::writeOnly);
+    std::memcpy(data.getLinePointer(0), row.data(), row.size() * sizeof(PixelARGB));
+}
+
+void SpectrogramImage::clear()
+{
+    image = {};
+    newestRow = 0;
+}
+
+void SpectrogramImage::draw(juce::Graphics& g, juce::Rectangle<float> bounds) const
+{
+    using namespace juce;
+
+    if( ! image.isValid() )
+        return;
+
+    Graphics::ScopedSaveState state(g);
+    g.reduceClipRegion(bounds.getSmallestIntegerContainer());
+
+    // the rows get stretched to the height of the bounds. nearest neighbour keeps the two pieces
+    // from blending into the transparent edges, where they'd leave a seam
+    g.setImageResamplingQuality(Graphics::lowResamplingQuality);
+
+    const auto height = image.getHeight();
+    const auto toBounds = AffineTransform::scale(bounds.getWidth() / float(image.getWidth()),
+                                                 bounds.getHeight() / float(height))
+                                          .translated(bounds.getX(), bounds.getY());
+
+    // the newest row up to the bottom of the image goes at the top, what wrapped round goes under it
+    g.drawImageTransformed(image, AffineTransform::translation(0.f, float(-newestRow)).followedBy(toBounds));
+
+    if( newestRow > 0 )
+        g.drawImageTransformed(image, AffineTransform::translation(0.f, float(height - newestRow)).followedBy(toBounds));
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    Spectrogram.h
+    Created: 17 Oct 2026 11:36:05pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectrumColumns.h"
+#include "../DSP/Fifo.h"
+
+/** 1 / RowsPerSecond of the analyzer's frames, as the spectrogram's pixels from MIN_FREQUENCY on the left to MAX_FREQUENCY on the right. */
+using SpectrogramRow = std::vector<juce::PixelARGB>;
+
+/**
+ Turns analyzer frames into SpectrogramRows on the AnalyzerThread, and hands them to
+ the message thread through a Fifo.
+
+ The time axis goes by the audio, not by the frames or the display: advance() puts out
+ a row for every 1 / RowsPerSecond seconds of samples the analyzer has read, so the
+ spectrogram scrolls at the same speed whatever the hop size, the refresh rate or the
+ sample rate. A row shows the loudest of the frames that came in during its time, or
+ repeats the row before if none did.
+
+ Each pixel is the louder of the two traces, looked up in a colour table that's made once
+ from ColorScheme::getSpectrogramGradient(), so a row costs one table lookup per pixel
+ on top of the SpectrumColumns lookups for the frames that went into it.
+ */
+struct SpectrogramGenerator
+{
+    static constexpr int NumColours = 256;
+
+    // the spectrogram always shows the last HistorySeconds, one row per 1 / RowsPerSecond
+    static constexpr int RowsPerSecond = 20;
+    static constexpr int HistorySeconds = 15;
+    static constexpr int NumRows = RowsPerSecond * HistorySeconds;
+
+    SpectrogramGenerator();
+
+    /**
+     takes a stitched frame into the row that's being put together, 'bands' says where
+     each band sits in the frames. 'second' can be nullptr, for the mono sum.
+     only allocates when the width changes, which starts the row over.
+     */
+    void addFrame(const float* first,
+                  const float* second,
+                  const std::vector<SpectrumBand>& bands,
+                  int width,
+                  float negativeInfinity);
+
+    /** numSamples more have been read, puts out a row for every 1 / RowsPerSecond seconds of them. */
+    void advance(int numSamples, double sampleRate);
+
+    /** forgets the row that's being put together, and the time since the last one. */
+    void reset();
+
+    int getNumRowsAvailable() const { return rowFifo.getNumAvailableForReading(); }
+
+    /** swaps the oldest row into 'row', the fifo reuses row's old storage. */
+    bool getRow(SpectrogramRow& row) { return rowFifo.pull(row); }
+private:
+    void pushRow();
+
+    std::array<juce::PixelARGB, NumColours> colours;
+    SpectrumColumns columns;
+
+    // the loudest value per pixel so far, in decibels, and where they'd be the first colour
+    std::vector<float> pending;
+    float pendingNegativeInfinity { -48.f };
+
+    // whether pending has anything to show yet, and whether a frame went into it since the last row.
+    // the first frame after a row overwrites it, the others only raise it.
+    bool hasPending { false };
+    bool rowHasFrames { false };
+
+    double samplesSinceLastRow { 0.0 };
+
+    Fifo<SpectrogramRow> rowFifo;
+};
+
+/**
+ The spectrogram's history, on the message thread. It's a ring of SpectrogramGenerator::NumRows
+ rows in an image as wide as the rows: a new row overwrites the oldest one and moves where the
+ ring starts, and draw() stretches the ring over the analysis area in two pieces starting from
+ the newest row, so the area always spans SpectrogramGenerator::HistorySeconds, however tall it is.
+ Nothing that's already in the image gets touched again, so adding a row is the same handful
+ of pixels however much history there is.
+ */
+struct SpectrogramImage
+{
+    /** writes 'row' over the oldest one. a different width than last time starts the history over. */
+    void addRow(const SpectrogramRow& row);
+
+    /** forgets the history. */
+    void clear();
+
+    /** the newest row at the top of 'bounds', HistorySeconds ago at the bottom. */
+    void draw(juce::Graphics& g, juce::Rectangle<float> bounds) const;
+private:
+    juce::Image image;
+
+    // where the newest row is in the image, the next one goes above it
+    int newestRow { 0 };
+};
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    SpectrumAverager.cpp
+    Created: 17 Oct 2026 8:05:36pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "SpectrumAverager.h"
+#include "SpectrumKernels.h"
+
+namespace
+{
+using SIMDType = juce::dsp::SIMDRegister<float>;
+using MaskType = SIMDType::vMaskType;
+constexpr int NumLanes = static_cast<int>(SIMDType::SIMDNumElements);
+
+// the vectors aren't necessarily aligned, memcpy makes these unaligned loads and stores
+SIMDType load(const float* source) noexcept
+{
+    SIMDType x;
+    std::memcpy(&x, source, sizeof(x));
+    return x;
+}
+
+void store(float* destination, SIMDType x) noexcept
+{
+    std::memcpy(destination, &x, sizeof(x));
+}
+
+/** a where mask is set, b everywhere else. */
+SIMDType select(MaskType mask, SIMDType a, SIMDType b) noexcept
+{
+    return (a & mask) + (b & ~mask);
+}
+
+int roundUpToLanes(int numBins)
+{
+    return (numBins + NumLanes - 1) / NumLanes * NumLanes;
+}
+
+// the average can't be 0 as long as the frames are floored at some negative infinity,
+// this only keeps the log finite if they aren't
+constexpr float MinDecibels = -300.f;
+}
+
+void SpectrumAverager::prepare(int maxFrameSize, int maxNumBands)
+{
+    maxPaddedSize = roundUpToLanes(maxFrameSize);
+    
+    // the Welch frames sit back to back at the current size, so this fits any smaller one too
+    averaged.assign(maxPaddedSize, 0.f);
+    welchFrames.assign(static_cast<size_t>(maxPaddedSize) * MaxWelchFrames, 0.f);
+    peaks.assign(maxPaddedSize, 0.f);
+    holdTimes.assign(maxPaddedSize, 0.f);
+    
+    bands.reserve(static_cast<size_t>(maxNumBands));
+    bands.clear();
+    paddedSize = 0;
+}
+
+void SpectrumAverager::setBands(const std::vector<SpectrumBand>& newBands)
+{
+    jassert(newBands.size() <= bands.capacity());
+    
+    bands.clear();
+    paddedSize = 0;
+    
+    for( const auto& newBand : newBands )
+    {
+        Band band;
+        band.offset = newBand.offset;
+        band.size = roundUpToLanes(newBand.numBins);
+        
+        // a register that straddled two bands would average one of them twice
+        jassert(band.offset % NumLanes == 0);
+        jassert(band.offset >= paddedSize);
+        
+        paddedSize = band.offset + band.size;
+        bands.push_back(band);
+    }
+    
+    jassert(paddedSize <= maxPaddedSize);
+    reset();
+}
+
+void SpectrumAverager::reset()
+{
+    for( auto& band : bands )
+        band = { band.offset, band.size };
+}
+
+void SpectrumAverager::process(const float* frame, const bool* newBands, const AnalyzerSettings& settings, float secondsSinceLastCall)
+{
+    jassert(paddedSize > 0);
+    
+    if( settings.averaging != averaging || settings.getNumWelchFrames() != numWelchFrames )
+    {
+        averaging = settings.averaging;
+        numWelchFrames = juce::jmin(settings.getNumWelchFrames(), MaxWelchFrames);
+        reset();
+    }
+    
+    for( size_t b = 0; b < bands.size(); ++b )
+    {
+        auto& band = bands[b];
+        band.secondsSinceLastFrame += secondsSinceLastCall;
+        
+        const bool isNew = newBands[b];
+        if( isNew )
+            average(band, frame, settings);
+        else if( ! band.hasAverage )
+            std::copy(frame + band.offset, frame + band.offset + band.size, averaged.begin() + band.offset);
+        
+        // a band that has just had its peaks switched on gets them straight away, not with its next FFT
+        if( settings.peakHold && (isNew || ! band.hasPeaks) )
+            holdPeaks(band);
+        
+        band.hasPeaks = settings.peakHold;
+        
+        if( isNew )
+            band.secondsSinceLastFrame = 0.f;
+    }
+}
+
+void SpectrumAverager::average(Band& band, const float* frame, const AnalyzerSettings& settings)
+{
+    if( averaging == AnalyzerAveraging::WelchAveraging )
+    {
+        averageWelch(band, frame);
+    }
+    else if( averaging == AnalyzerAveraging::ExponentialAveraging && band.hasAverage )
+    {
+        // a one pole smoother, with the band's own frame rate, whatever the hop and the refresh made it
+        const auto alpha = SIMDType::expand(1.f - std::exp(-band.secondsSinceLastFrame / settings.getAveragingTime()));
+        
+        for( int i = band.offset; i < band.offset + band.size; i += NumLanes )
+        {
+            auto a = load(averaged.data() + i);
+            store(averaged.data() + i, a + alpha * (load(frame + i) - a));
+        }
+    }
+    else
+    {
+        std::copy(frame + band.offset, frame + band.offset + band.size, averaged.begin() + band.offset);
+    }
+    
+    band.hasAverage = true;
+}
+
+void SpectrumAverager::averageWelch(Band& band, const float* frame)
+{
+    const auto begin = band.offset, end = band.offset + band.size;
+    
+    // the newest frame's power takes the place of the band's oldest
+    auto* slot = welchFrames.data() + static_cast<size_t>(band.welchIndex) * paddedSize;
+    decibelsToPowers(frame + begin, slot + begin, band.size);
+    
+    band.welchIndex = (band.welchIndex + 1) % numWelchFrames;
+    band.welchCount = juce::jmin(band.welchCount + 1, numWelchFrames);
+    
+    // added up from scratch every time, at most 16 frames. a running sum would be cheaper,
+    // but once a loud frame leaves it, its rounding error swamps the quiet ones that are left.
+    auto* sum = averaged.data();
+    std::copy(welchFrames.begin() + begin, welchFrames.begin() + end, sum + begin);
+    
+    for( int f = 1; f < band.welchCount; ++f )
+    {
+        const auto* frameSlot = welchFrames.data() + static_cast<size_t>(f) * paddedSize;
+        for( int i = begin; i < end; i += NumLanes )
+            store(sum + i, load(sum + i) + load(frameSlot + i));
+    }
+    
+    powersToDecibels(sum + begin, band.size, 1.f / float(band.welchCount), MinDecibels);
+}
+
+void SpectrumAverager::holdPeaks(const Band& band)
+{
+    const auto begin = band.offset, end = band.offset + band.size;
+    
+    if( ! band.hasPeaks )
+    {
+        std::copy(averaged.begin() + begin, averaged.begin() + end, peaks.begin() + begin);
+        std::fill(holdTimes.begin() + begin, holdTimes.begin() + end, 0.f);
+        return;
+    }
+    
+    const auto elapsed = SIMDType::expand(band.secondsSinceLastFrame);
+    const auto holdTime = SIMDType::expand(PeakHoldSeconds);
+    const auto decay = SIMDType::expand(PeakDecayDbPerSecond * band.secondsSinceLastFrame);
+    const auto zero = SIMDType::expand(0.f);
+    
+    for( int i = begin; i < end; i += NumLanes )
+    {
+        auto x = load(averaged.data() + i);
+        auto peak = load(peaks.data() + i);
+        auto held = load(holdTimes.data() + i) + elapsed;
+        
+        // a new peak restarts the hold, once the hold is up the peak falls until the signal catches it
+        auto isNewPeak = SIMDType::greaterThanOrEqual(x, peak);
+        auto isDecaying = SIMDType::greaterThan(held, holdTime);
+        auto fallen = SIMDType::max(x, peak - decay);
+        
+        peak = select(isNewPeak, x, select(isDecaying, fallen, peak));
+        held = select(isNewPeak, zero, held);
+        
+        store(peaks.data() + i, peak);
+        store(holdTimes.data() + i, held);
+    }
+}
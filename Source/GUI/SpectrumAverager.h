@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SpectrumAverager.h
+    Created: 17 Oct 2026 8:05:36pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerSettings.h"
+#include "SpectrumBand.h"
+
+/**
+ Sits between the analyzer and the AnalyzerPathGenerator and steadies
+ one trace: exponential or Welch averaging, and optionally the peaks of that average,
+ held and decaying, as a second trace drawn over it.
+
+ Everything works on the decibel frames the analyzer hands out, in place on
+ arrays allocated by prepare(). The exponential averaging smooths the decibel values,
+ a SIMD register of bins at a time. Welch averaging is Welch's method: the mean power of
+ the last few (overlapping) frames, converted back to decibels, so noise reads at its
+ actual level instead of the 2.5 dB or so lower a mean of decibels gives.
+
+ The analyzer's bands update at different rates, so each band is averaged on its own,
+ only when it has a new FFT, with its own count of Welch frames and its own time since
+ its last one. A band that wasn't transformed is left as it was, rather than averaged
+ again with the same values. For that, each band has to start on a whole SIMD register,
+ and its last register can't reach into the next band.
+ */
+struct SpectrumAverager
+{
+    static constexpr int MaxWelchFrames = 16;
+    
+    // peaks hold for this long, then fall at this rate
+    static constexpr float PeakHoldSeconds = 1.f;
+    static constexpr float PeakDecayDbPerSecond = 12.f;
+    
+    /** allocates for frames of up to maxFrameSize values in up to maxNumBands bands. */
+    void prepare(int maxFrameSize, int maxNumBands);
+    
+    /** switches to another band layout within what prepare() allocated for, and forgets everything so far. */
+    void setBands(const std::vector<SpectrumBand>& bands);
+    void reset();
+    
+    /**
+     mixes the bands that newBands[band] says have a new FFT into the average,
+     secondsSinceLastCall after the call before. frame has to be laid out as setBands() said.
+     */
+    void process(const float* frame, const bool* newBands, const AnalyzerSettings& settings, float secondsSinceLastCall);
+    
+    /** the averaged trace, laid out like the frames (plus padding). */
+    const std::vector<float>& getAverage() const { return averaged; }
+    
+    /** the held peaks of the average, the same size. only kept up to date while the settings ask for peak hold. */
+    const std::vector<float>& getPeaks() const { return peaks; }
+    
+    /** the frame size, up to the end of the last band's last SIMD register. */
+    int getPaddedSize() const { return paddedSize; }
+private:
+    /** one band's bins in the frames, rounded up to whole SIMD registers, and how far its averaging has got. */
+    struct Band
+    {
+        int offset { 0 }, size { 0 };
+        bool hasAverage { false }, hasPeaks { false };
+        int welchIndex { 0 }, welchCount { 0 };
+        float secondsSinceLastFrame { 0.f };
+    };
+    
+    void average(Band& band, const float* frame, const AnalyzerSettings& settings);
+    void averageWelch(Band& band, const float* frame);
+    void holdPeaks(const Band& band);
+    
+    int paddedSize { 0 }, maxPaddedSize { 0 };
+    std::vector<Band> bands;
+    
+    std::vector<float> averaged;
+    
+    AnalyzerAveraging averaging { AnalyzerAveraging::NoAveraging };
+    int numWelchFrames { 0 };
+    
+    // the power of the last numWelchFrames frames back to back, each band at its own offset in them
+    std::vector<float> welchFrames;
+    
+    std::vector<float> peaks, holdTimes;
+};
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    SpectrumBand.h
+    Created: 17 Oct 2026 9:14:22pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/**
+ One stretch of a stitched spectrum frame: the frame holds numBins bins of the band's
+ own FFT from firstBin on, starting at frame[offset]. The band gets drawn from
+ lowestFrequency up to highestFrequency, where the next one takes over.
+ */
+struct SpectrumBand
+{
+    int offset { 0 };
+    int firstBin { 0 };
+    int numBins { 0 };
+    float binWidth { 0.f };
+    float lowestFrequency { 0.f };
+    float highestFrequency { 0.f };
+
+    bool operator==(const SpectrumBand& other) const
+    {
+        return offset == other.offset
+            && firstBin == other.firstBin
+            && numBins == other.numBins
+            && binWidth == other.binWidth
+            && lowestFrequency == other.lowestFrequency
+            && highestFrequency == other.highestFrequency;
+    }
+
+    bool operator!=(const SpectrumBand& other) const { return ! (*this == other); }
+};
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    SpectrumColumns.h
+    Created: 17 Oct 2026 11:36:05pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utilities.h"
+#include "SpectrumBand.h"
+
+/**
+ Which bins of a stitched spectrum frame land in which of numColumns pixels,
+ log spaced from MIN_FREQUENCY to MAX_FREQUENCY, lowest first.
+
+ Each pixel is read from the band that covers its centre frequency. Where it covers
+ several bins it shows their maximum, where the bins are wider than it
+ it interpolates between the two nearest. The table only gets rebuilt when
+ the band layout or the number of pixels changes.
+ */
+struct SpectrumColumns
+{
+    void update(const std::vector<SpectrumBand>& bands, int numColumns)
+    {
+        if( numColumns == columnsSize && bands == columnsBands )
+            return;
+
+        columnsSize = numColumns;
+        columnsBands = bands;
+
+        auto getFrequency = [numColumns](float x)
+        {
+            return juce::mapToLog10(x / float(numColumns), MIN_FREQUENCY, MAX_FREQUENCY);
+        };
+
+        columns.resize(static_cast<size_t>(numColumns));
+        for( int x = 0; x < numColumns; ++x )
+        {
+            auto& column = columns[x];
+            auto centre = getFrequency(x + 0.5f);
+
+            auto band = std::find_if(bands.begin(), bands.end(), [centre](const auto& b)
+            {
+                return centre >= b.lowestFrequency && centre < b.highestFrequency;
+            });
+
+            if( band == bands.end() )
+                band = centre < bands.front().lowestFrequency ? bands.begin() : bands.end() - 1;
+
+            // where a frequency falls in the frame, in bins
+            auto getPosition = [&band](float freq)
+            {
+                return freq / band->binWidth - float(band->firstBin - band->offset);
+            };
+
+            // the bins the frame holds for this band
+            const int firstIndex = band->offset;
+            const int lastIndex = band->offset + band->numBins - 1;
+
+            // the bins whose centres fall in [x, x + 1), end is one past the last of them
+            auto first = juce::jlimit(firstIndex, lastIndex, (int)std::ceil(getPosition(getFrequency(float(x)))));
+            auto end = juce::jlimit(firstIndex, lastIndex + 1, (int)std::ceil(getPosition(getFrequency(float(x + 1)))));
+
+            if( end > first )
+            {
+                column.firstBin = first;
+                column.numBins = end - first;
+                column.fraction = 0.f;
+            }
+            else
+            {
+                // the last bin needs a neighbour to interpolate to
+                auto position = juce::jlimit(float(firstIndex), float(lastIndex - 1), getPosition(centre));
+                column.firstBin = (int)position;
+                column.numBins = 0;
+                column.fraction = position - column.firstBin;
+            }
+        }
+    }
+
+    int size() const { return columnsSize; }
+
+    /** what pixel x shows of the frame 'data', which has to be laid out like the bands update() got. */
+    float getValue(const float* data, int x) const
+    {
+        const auto& column = columns[x];
+
+        if( column.numBins > 0 )
+        {
+            // vectorized in juce
+            return juce::FloatVectorOperations::findMaximum(data + column.firstBin, column.numBins);
+        }
+
+        return data[column.firstBin] + column.fraction * (data[column.firstBin + 1] - data[column.firstBin]);
+    }
+private:
+    /** the bins of one pixel, as indices into the frame: numBins of them from firstBin on,
+        or, if numBins is 0, 'fraction' of the way from firstBin to the next one. */
+    struct ColumnBins
+    {
+        int firstBin { 0 };
+        int numBins { 0 };
+        float fraction { 0.f };
+    };
+
+    std::vector<ColumnBins> columns;
+    std::vector<SpectrumBand> columnsBands;
+    int columnsSize { 0 };
+};
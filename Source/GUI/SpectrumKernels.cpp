@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.cpp
+    Created: 17 Oct 2026 7:21:54pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "SpectrumKernels.h"
+
+namespace
+{
+using SIMDType = juce::dsp::SIMDRegister<float>;
+using MaskType = SIMDType::vMaskType;
+constexpr int NumLanes = static_cast<int>(SIMDType::SIMDNumElements);
+
+/** every lane's bits read as an int32, converted to float. */
+SIMDType bitsToFloat(SIMDType x) noexcept
+{
+#if JUCE_USE_AVX_INTRINSICS
+    return SIMDType::fromNative(_mm256_cvtepi32_ps(_mm256_castps_si256(x.value)));
+#elif JUCE_USE_SSE_INTRINSICS
+    return SIMDType::fromNative(_mm_cvtepi32_ps(_mm_castps_si128(x.value)));
+#elif JUCE_USE_ARM_NEON
+    return SIMDType::fromNative(vcvtq_f32_s32(vreinterpretq_s32_f32(x.value)));
+#else
+    for( size_t i = 0; i < SIMDType::SIMDNumElements; ++i )
+    {
+        auto value = x.get(i);
+        juce::int32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        x.set(i, static_cast<float>(bits));
+    }
+    return x;
+#endif
+}
+
+/** every lane rounded to the nearest int32, its bits read as a float. the inverse of bitsToFloat(). */
+SIMDType floatToBits(SIMDType x) noexcept
+{
+#if JUCE_USE_AVX_INTRINSICS
+    return SIMDType::fromNative(_mm256_castsi256_ps(_mm256_cvtps_epi32(x.value)));
+#elif JUCE_USE_SSE_INTRINSICS
+    return SIMDType::fromNative(_mm_castsi128_ps(_mm_cvtps_epi32(x.value)));
+#elif JUCE_USE_ARM_NEON
+    return SIMDType::fromNative(vreinterpretq_f32_s32(vcvtnq_s32_f32(x.value)));
+#else
+    for( size_t i = 0; i < SIMDType::SIMDNumElements; ++i )
+    {
+        auto bits = static_cast<juce::int32>(std::lrint(x.get(i)));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        x.set(i, value);
+    }
+    return x;
+#endif
+}
+
+/** log2 of positive, normal, finite x. */
+SIMDType fastLog2(SIMDType x) noexcept
+{
+    // x = 2^e * (1 + t) with t in [0, 1), and the bits of x read as an int
+    // are (e + 127 + t) * 2^23. so that gives e + t, and the mantissa bits give t.
+    const auto mantissa = (x & MaskType::expand(0x007fffffu)) | MaskType::expand(0x3f800000u);
+    const auto t = mantissa - SIMDType::expand(1.f);
+    const auto exponentPlusT = bitsToFloat(x) * SIMDType::expand(1.f / 8388608.f) - SIMDType::expand(127.f);
+
+    // log2(1 + t) on [0, 1), a minimax fit that's within 1.5e-5 of it
+    auto p = SIMDType::expand(0.0463807425f);
+    p = p * t + SIMDType::expand(-0.196258407f);
+    p = p * t + SIMDType::expand(0.417586361f);
+    p = p * t + SIMDType::expand(-0.709659697f);
+    p = p * t + SIMDType::expand(1.44196529f);
+    p = p * t;
+
+    return exponentPlusT - t + p;
+}
+
+/** 2^x for x in [-126, 127], so the result is a normal float. */
+SIMDType fastExp2(SIMDType x) noexcept
+{
+    // x = n + t with n the nearest integer and t in [-0.5, 0.5].
+    // 2^n is a float with n + 127 in its exponent bits and nothing in its mantissa.
+    const auto n = bitsToFloat(floatToBits(x));
+    const auto t = x - n;
+    const auto twoToTheN = floatToBits((n + SIMDType::expand(127.f)) * SIMDType::expand(8388608.f));
+
+    // 2^t on [-0.5, 0.5], its Taylor series up to t^5, within 4e-6 of it
+    auto p = SIMDType::expand(1.33335581e-3f);
+    p = p * t + SIMDType::expand(9.61812911e-3f);
+    p = p * t + SIMDType::expand(5.55041087e-2f);
+    p = p * t + SIMDType::expand(2.40226507e-1f);
+    p = p * t + SIMDType::expand(6.93147181e-1f);
+    p = p * t + SIMDType::expand(1.f);
+
+    return twoToTheN * p;
+}
+
+/** in place, data[i] = decibelsPerOctave * log2(data[i] * scale), with data[i] * scale floored at minValue first. */
+void toDecibels(float* data, int numValues, float scale, float minValue, float decibelsPerOctave, float negativeInfinity) noexcept
+{
+    const auto vScale = SIMDType::expand(scale);
+    const auto vMinValue = SIMDType::expand(minValue);
+    const auto vNegativeInfinity = SIMDType::expand(negativeInfinity);
+    const auto infinity = SIMDType::expand(std::numeric_limits<float>::infinity());
+    const auto vDecibelsPerOctave = SIMDType::expand(decibelsPerOctave);
+
+    auto convert = [&](SIMDType x)
+    {
+        x = x * vScale;
+
+        // NaN and inf fail the compare and become 0
+        x = x & SIMDType::lessThan(x, infinity);
+        x = SIMDType::max(x, vMinValue);
+
+        return SIMDType::max(fastLog2(x) * vDecibelsPerOctave, vNegativeInfinity);
+    };
+
+    // the fifo's vectors aren't necessarily aligned, memcpy makes these unaligned loads and stores
+    int i = 0;
+    for( ; i + NumLanes <= numValues; i += NumLanes )
+    {
+        SIMDType x;
+        std::memcpy(&x, data + i, sizeof(x));
+        x = convert(x);
+        std::memcpy(data + i, &x, sizeof(x));
+    }
+
+    if( i < numValues )
+    {
+        const auto numLeft = static_cast<size_t>(numValues - i) * sizeof(float);
+
+        auto x = SIMDType::expand(0.f);
+        std::memcpy(&x, data + i, numLeft);
+        x = convert(x);
+        std::memcpy(data + i, &x, numLeft);
+    }
+}
+}
+
+void magnitudesToDecibels(float* data, int numValues, float scale, float negativeInfinity) noexcept
+{
+    // anything quieter than negativeInfinity comes out as negativeInfinity anyway,
+    // and clamping to it first keeps zeros and denormals away from the log
+    const auto minGain = juce::jmax(std::numeric_limits<float>::min(),
+                                    juce::Decibels::decibelsToGain(negativeInfinity, -1000.f));
+
+    toDecibels(data, numValues, scale, minGain, 20.f * std::log10(2.f), negativeInfinity);
+}
+
+void powersToDecibels(float* data, int numValues, float scale, float negativeInfinity) noexcept
+{
+    const auto minPower = juce::jmax(std::numeric_limits<float>::min(),
+                                     std::pow(10.f, negativeInfinity / 10.f));
+
+    toDecibels(data, numValues, scale, minPower, 10.f * std::log10(2.f), negativeInfinity);
+}
+
+void decibelsToPowers(const float* decibels, float* powers, int numValues) noexcept
+{
+    // 10^(x / 10) = 2^(x log2(10) / 10)
+    const auto octavesPerDecibel = SIMDType::expand(std::log2(10.f) / 10.f);
+    const auto lowest = SIMDType::expand(-126.f);
+    const auto highest = SIMDType::expand(127.f);
+
+    auto convert = [&](SIMDType x)
+    {
+        return fastExp2(SIMDType::min(SIMDType::max(x * octavesPerDecibel, lowest), highest));
+    };
+
+    int i = 0;
+    for( ; i + NumLanes <= numValues; i += NumLanes )
+    {
+        SIMDType x;
+        std::memcpy(&x, decibels + i, sizeof(x));
+        x = convert(x);
+        std::memcpy(powers + i, &x, sizeof(x));
+    }
+
+    if( i < numValues )
+    {
+        const auto numLeft = static_cast<size_t>(numValues - i) * sizeof(float);
+
+        auto x = SIMDType::expand(0.f);
+        std::memcpy(&x, decibels + i, numLeft);
+        x = convert(x);
+        std::memcpy(powers + i, &x, numLeft);
+    }
+}
+
+void magnitudesToDecibelsReference(float* data, int numValues, float scale, float negativeInfinity) noexcept
+{
+    //normalize the fft values.
+    for( int i = 0; i < numValues; ++i )
+    {
+        auto v = data[i];
+        if( !std::isinf(v) && !std::isnan(v) )
+        {
+            v *= scale;
+        }
+        else
+        {
+            v = 0.f;
+        }
+        data[i] = v;
+    }
+
+    //convert them to decibels
+    for( int i = 0; i < numValues; ++i )
+    {
+        data[i] = juce::Decibels::gainToDecibels(data[i], negativeInfinity);
+    }
+}
+
+void splitTwoRealMagnitudes(const juce::dsp::Complex<float>* spectrum,
+                            int fftSize,
+                            int firstBin,
+                            int numBins,
+                            float* first,
+                            float* second) noexcept
+{
+    for( int i = 0; i < numBins; ++i )
+    {
+        const auto k = firstBin + i;
+        const auto z = spectrum[k];
+        const auto mirrored = std::conj(spectrum[(fftSize - k) & (fftSize - 1)]);
+
+        first[i] = 0.5f * std::abs(z + mirrored);
+        second[i] = 0.5f * std::abs(z - mirrored);
+    }
+}
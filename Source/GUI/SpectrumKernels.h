@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    SpectrumKernels.h
+    Created: 17 Oct 2026 7:21:54pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ In place, data[i] = 20 * log10(data[i] * scale), floored at negativeInfinity.
+ NaN and inf come out as negativeInfinity, the same as silence.
+
+ The normalization, the scrubbing and the conversion to decibels are one
+ branch-free SIMD pass. log2 is taken from the float's exponent plus a degree 5
+ polynomial for its mantissa, which keeps the result within 0.0002 dB of
+ juce::Decibels::gainToDecibels for every normal input. The analyzer benchmarks
+ measure both the speed and the error against magnitudesToDecibelsReference().
+ */
+void magnitudesToDecibels(float* data, int numValues, float scale, float negativeInfinity) noexcept;
+
+/** the scalar loops magnitudesToDecibels() replaced, kept to check it against. */
+void magnitudesToDecibelsReference(float* data, int numValues, float scale, float negativeInfinity) noexcept;
+
+/** the same for powers, data[i] = 10 * log10(data[i] * scale), with the same log2 and floor. */
+void powersToDecibels(float* data, int numValues, float scale, float negativeInfinity) noexcept;
+
+/**
+ powers[i] = 10^(decibels[i] / 10), the other way. 2^x is a float built from the integer
+ nearest x plus a degree 5 polynomial for what's left, within 0.00003 dB of std::pow.
+ Anything below -379 dB comes out as the smallest normal float, above 382 dB as the largest power of 2.
+ */
+void decibelsToPowers(const float* decibels, float* powers, int numValues) noexcept;
+
+/**
+ Pulls the spectra of two real signals x and y apart again after one complex FFT
+ of z = x + iy, using the conjugate symmetry real signals have:
+ X[k] = (Z[k] + Z*[N-k]) / 2, Y[k] = (Z[k] - Z*[N-k]) / 2i.
+ Writes |X[k]| and |Y[k]| of the numBins bins from firstBin on to first[] and second[].
+ */
+void splitTwoRealMagnitudes(const juce::dsp::Complex<float>* spectrum,
+                            int fftSize,
+                            int firstBin,
+                            int numBins,
+                            float* first,
+                            float* second) noexcept;
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    SpriteCache.cpp
+    Created: 18 Oct 2026 12:41:19am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "SpriteCache.h"
+
+void SpriteCache::draw(juce::Graphics& g, const juce::Image& sprite, juce::Rectangle<float> bounds)
+{
+    g.drawImage(sprite, bounds);
+}
+
+float SpriteCache::getScale(juce::Graphics& g)
+{
+    return g.getInternalContext().getPhysicalPixelScaleFactor();
+}
+
+void SpriteCache::clear()
+{
+    sprites.clear();
+    numBytes = 0;
+}
+
+juce::Image SpriteCache::createImage(const Key& key)
+{
+    using namespace juce;
+
+    jassert(key.width > 0 && key.height > 0);
+
+    return Image(Image::PixelFormat::ARGB,
+                 jmax(1, roundToInt(key.width * key.scale)),
+                 jmax(1, roundToInt(key.height * key.scale)),
+                 true);
+}
+
+size_t SpriteCache::getNumBytes(const juce::Image& image)
+{
+    return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) * 4;
+}
+
+void SpriteCache::removeLeastRecentlyUsed()
+{
+    while( numBytes > MaxBytes && sprites.size() > 1 )
+    {
+        auto oldest = std::min_element(sprites.begin(), sprites.end(), [](const auto& a, const auto& b)
+        {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+
+        numBytes -= getNumBytes(oldest->second.image);
+        sprites.erase(oldest);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    SpriteCache.h
+    Created: 18 Oct 2026 12:41:19am
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Images of things the LookAndFeel draws over and over, rendered once at the display's
+ scale and blitted after that. A sprite is whatever the drawing depends on (which one it is,
+ its size, the scale and its state) and gets rendered the first time it's asked for.
+
+ The least recently used sprites go once they add up to more than MaxBytes, so sweeping
+ a knob through all its frames on a big display can't grow the cache without bound.
+ Message thread only, like everything else a LookAndFeel does.
+ */
+struct SpriteCache
+{
+    static constexpr size_t MaxBytes = 32 * 1024 * 1024;
+
+    struct Key
+    {
+        int sprite { 0 };           // which drawing, up to whoever draws them
+        int width { 0 }, height { 0 };
+        float scale { 1.f };        // physical pixels per unit
+        int state { 0 };            // enabled, toggled, ...
+        float value { 0.f };        // a knob's angle, ...
+
+        bool operator<(const Key& other) const
+        {
+            return std::tie(sprite, width, height, scale, state, value)
+                 < std::tie(other.sprite, other.width, other.height, other.scale, other.state, other.value);
+        }
+    };
+
+    /**
+     the sprite for 'key'. the first time round, 'render' gets called with a Graphics
+     that goes from (0, 0) to (key.width, key.height) at key.scale to draw it.
+     */
+    template<typename Render>
+    const juce::Image& get(const Key& key, Render&& render)
+    {
+        auto sprite = sprites.find(key);
+        if( sprite == sprites.end() )
+        {
+            auto image = createImage(key);
+            {
+                juce::Graphics g(image);
+                g.addTransform(juce::AffineTransform::scale(image.getWidth() / float(key.width),
+                                                            image.getHeight() / float(key.height)));
+                render(g);
+            }
+
+            numBytes += getNumBytes(image);
+            sprite = sprites.emplace(key, Sprite { image, 0 }).first;
+        }
+
+        sprite->second.lastUsed = ++useCount;
+
+        if( numBytes > MaxBytes )
+            removeLeastRecentlyUsed();
+
+        return sprite->second.image;
+    }
+
+    /** draws a sprite over 'bounds', one image pixel to one physical pixel if the scale's right. */
+    static void draw(juce::Graphics& g, const juce::Image& sprite, juce::Rectangle<float> bounds);
+
+    /** how many physical pixels a unit of 'g' is, for Key::scale. */
+    static float getScale(juce::Graphics& g);
+
+    void clear();
+private:
+    struct Sprite
+    {
+        juce::Image image;
+        juce::uint64 lastUsed;
+    };
+
+    static juce::Image createImage(const Key& key);
+    static size_t getNumBytes(const juce::Image& image);
+
+    /** down to MaxBytes, never the sprite that was used last. */
+    void removeLeastRecentlyUsed();
+
+    std::map<Key, Sprite> sprites;
+    size_t numBytes { 0 };
+    juce::uint64 useCount { 0 };
+};
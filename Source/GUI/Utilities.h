@@ -11,12 +11,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../DSP/ParameterRanges.h"
 
-#define MIN_FREQUENCY 20.f
-#define MAX_FREQUENCY 20000.f
-
-#define MIN_GAIN -24.f
-#define MAX_GAIN 24.f
 #define GAIN_STEP_SIZE 6
 
 template<
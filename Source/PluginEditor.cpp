@@ -60,15 +60,25 @@ analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyz
     highCutSlopeSlider.labels.add({0.f, "12"});
     highCutSlopeSlider.labels.add({1.f, "48"});
     
+    if( auto* analyzerMode = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Analyzer Mode")) )
+        analyzerModeBox.addItemList(analyzerMode->choices, 1);
+    
+    analyzerModeBoxAttachment = std::make_unique<APVTS::ComboBoxAttachment>(audioProcessor.apvts, "Analyzer Mode", analyzerModeBox);
+    
+    if( auto* analyzerView = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Analyzer View")) )
+        analyzerViewBox.addItemList(analyzerView->choices, 1);
+    
+    analyzerViewBoxAttachment = std::make_unique<APVTS::ComboBoxAttachment>(audioProcessor.apvts, "Analyzer View", analyzerViewBox);
+    
     for(auto* comp : getComps())
     {
         addAndMakeVisible(comp);
     }
     
-    lowcutBypassButton.setLookAndFeel(&lnf);
-    peakBypassButton.setLookAndFeel(&lnf);
-    highcutBypassButton.setLookAndFeel(&lnf);
-    analyzerEnabledButton.setLookAndFeel(&lnf);
+    lowcutBypassButton.setLookAndFeel(lnf.get());
+    peakBypassButton.setLookAndFeel(lnf.get());
+    highcutBypassButton.setLookAndFeel(lnf.get());
+    analyzerEnabledButton.setLookAndFeel(lnf.get());
     
     auto safePtr = juce::Component::SafePointer<SimpleEQAudioProcessorEditor>(this);
        peakBypassButton.onClick = [safePtr]()
@@ -151,11 +161,15 @@ void SimpleEQAudioProcessorEditor::resized()
     // subcomponents in your editor..
     auto bounds = getLocalBounds();
     auto analyzerEnabledArea = bounds.removeFromTop(25);
+    auto analyzerModeArea = analyzerEnabledArea.removeFromRight(110).reduced(0, 2);
+    auto analyzerViewArea = analyzerEnabledArea.removeFromRight(110).reduced(0, 2);
     analyzerEnabledArea.setWidth(100);
     analyzerEnabledArea.setX(5);
     analyzerEnabledArea.removeFromTop(2);
     
     analyzerEnabledButton.setBounds(analyzerEnabledArea);
+    analyzerModeBox.setBounds(analyzerModeArea.withTrimmedRight(5));
+    analyzerViewBox.setBounds(analyzerViewArea.withTrimmedRight(5));
     
     bounds.removeFromTop(5);
     auto responseArea = bounds.removeFromTop(180);
@@ -199,6 +213,8 @@ std::vector<juce::Component*> SimpleEQAudioProcessorEditor::getComps()
         &lowcutBypassButton,
         &peakBypassButton,
         &highcutBypassButton,
-        &analyzerEnabledButton
+        &analyzerEnabledButton,
+        &analyzerModeBox,
+        &analyzerViewBox
     };
 }
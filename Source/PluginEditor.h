@@ -62,6 +62,7 @@ private:
     
     PowerButton lowcutBypassButton, peakBypassButton, highcutBypassButton;
     AnalyzerButton analyzerEnabledButton;
+    juce::ComboBox analyzerModeBox, analyzerViewBox;
     
     using ButtonAttachement = APVTS::ButtonAttachment;
     ButtonAttachement lowcutBypassButtonAttachment,
@@ -69,9 +70,14 @@ private:
                       highcutBypassButtonAttachment,
                       analyzerEnabledButtonAttachment;
     
+    // made once the box has its items, or the attachment can't select the current one
+    std::unique_ptr<APVTS::ComboBoxAttachment> analyzerModeBoxAttachment,
+                                               analyzerViewBoxAttachment;
+    
     std::vector<juce::Component*> getComps();
     
-    LookAndFeel lnf;
+    // the same one the sliders use
+    juce::SharedResourcePointer<LookAndFeel> lnf;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessorEditor)
 };
@@ -8,7 +8,6 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "GUI/Utilities.h"
 
 //==============================================================================
 SimpleEQAudioProcessor::SimpleEQAudioProcessor()
@@ -99,12 +98,16 @@ void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
+    spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    filterEngine.prepare(spec);
     
+    // built once per sample rate and shared with every other instance
+    auto cutTable = cutCoefficientTables->getTable(sampleRate);
+    
+    coefficientDesigner.prepare(sampleRate, cutTable);
+    smoother.prepare(sampleRate, cutTable);
     updateFilters();
     
     leftChannelFifo.prepare(samplesPerBlock);
@@ -124,12 +127,11 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Anything from mono up to 7.1.4 works, the filter engine packs
+    // the channels into SIMD lanes and runs them all with the same coefficients.
+    const auto& mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput.isDisabled()
+     || mainOutput.size() > static_cast<int>(SIMDFilterEngine::MaxChannels))
         return false;
 
     // This checks if the input layout matches the output layout
@@ -158,18 +160,30 @@ void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
+    // when rendering offline the host doesn't wait for the designer thread,
+    // so design here to keep automation sample accurate to the block.
+    if( isNonRealtime() )
+        coefficientDesigner.designIfNeeded();
+    
     updateFilters();
     
     juce::dsp::AudioBlock<float> block(buffer);
     
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
-    
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-    
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    auto smoothingInterval = getSmoothingInterval();
+    if( smoothingInterval > 0 && smoother.isSmoothing() )
+    {
+        processSmoothed(block, smoothingInterval);
+    }
+    else
+    {
+        // smoothing was switched off half way through a glide
+        if( smoother.isSmoothing() )
+            finishSmoothing();
+        
+        // all channels in one pass, one per SIMD lane
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        filterEngine.process(context);
+    }
     
     leftChannelFifo.update(buffer);
     rightChannelFifo.update(buffer);
@@ -207,133 +221,111 @@ void SimpleEQAudioProcessor::setStateInformation (const void* data, int sizeInBy
     if(tree.isValid())
     {
         apvts.replaceState(tree);
-        updateFilters();
+        coefficientDesigner.designNow();
     }
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+void SimpleEQAudioProcessor::updatePeakFilter(const FilterCoefficients& coefficients)
 {
-    ChainSettings settings;
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
-    
-    settings.lowCutBypassed = apvts.getRawParameterValue("LowCut Bypassed")->load() > 0.5f;
-    settings.peakBypassed = apvts.getRawParameterValue("Peak Bypassed")->load() > 0.5f;
-    settings.highCutBypassed = apvts.getRawParameterValue("HighCut Bypassed")->load() > 0.5f;
-    settings.analyzerEnabled = apvts.getRawParameterValue("Analyzer Enabled")->load() > 0.5f;
-    
-    return settings;
+    filterEngine.setPeak(coefficients.peak, coefficients.peakBypassed);
 }
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double samplerate)
+void SimpleEQAudioProcessor::updateLowCutFilters(const FilterCoefficients& coefficients)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(samplerate,
-                                                        chainSettings.peakFreq,
-                                                        chainSettings.peakQuality,
-                                                        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+    filterEngine.setLowCut(coefficients.lowCut);
 }
 
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::updateHighCutFilters(const FilterCoefficients& coefficients)
 {
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients , peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients , peakCoefficients);
-        
-    leftChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    rightChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+    filterEngine.setHighCut(coefficients.highCut);
 }
 
-void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+void SimpleEQAudioProcessor::updateFilters()
 {
-    *old = *replacements;
+    // only an index swap, the designing happens on the CoefficientDesigner thread.
+    if( ! coefficientDesigner.pullLatest() )
+        return;
+    
+    const auto& coefficients = coefficientDesigner.getCoefficients();
+    const auto& versions = coefficients.bandVersions;
+    const bool smoothing = getSmoothingInterval() > 0;
+    
+    // a changed band either glides towards the new snapshot in processSmoothed(),
+    // or, when it can't (slope, bypass, smoothing off), gets applied right away.
+    auto needsUpdate = [&](int band)
+    {
+        if( versions[band] == appliedBandVersions[band] )
+            return false;
+        
+        if( smoothing && smoother.glideTo(coefficients, band) )
+            return false;
+        
+        smoother.jumpTo(coefficients, band);
+        return true;
+    };
+    
+    if( needsUpdate(ChainPositions::LowCut) )
+        updateLowCutFilters(coefficients);
+    if( needsUpdate(ChainPositions::Peak) )
+        updatePeakFilter(coefficients);
+    if( needsUpdate(ChainPositions::HighCut) )
+        updateHighCutFilters(coefficients);
+    
+    appliedBandVersions = versions;
 }
 
-void SimpleEQAudioProcessor::updateLowCutFilters(const ChainSettings& chainSettings)
+int SimpleEQAudioProcessor::getSmoothingInterval() const
 {
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
-    auto &leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    auto &rightLowCut = rightChain.get<ChainPositions::LowCut>();
+    // indexed by the "Smoothing" choices
+    static constexpr std::array<int, 4> intervals { 0, 16, 32, 64 };
     
-    leftChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    rightChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+    auto index = static_cast<size_t>(smoothingParameter->load());
+    return intervals[juce::jmin(index, intervals.size() - 1)];
 }
 
-void SimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings& chainSettings)
+void SimpleEQAudioProcessor::processSmoothed(juce::dsp::AudioBlock<float>& block, int interval)
 {
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
-    
-    auto &leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    auto &rightHighCut = rightChain.get<ChainPositions::HighCut>();
-    
-    leftChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    rightChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    const auto numSamples = block.getNumSamples();
     
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    for( size_t start = 0; start < numSamples; start += static_cast<size_t>(interval) )
+    {
+        auto length = juce::jmin(static_cast<size_t>(interval), numSamples - start);
+        
+        // redesign at the end of the sub-block, the engine ramps linearly towards it
+        if( smoother.isSmoothing() )
+        {
+            auto changedBands = smoother.advance(static_cast<int>(length));
+            const auto& coefficients = smoother.getCoefficients();
+            
+            if( changedBands & (1 << ChainPositions::LowCut) )
+                filterEngine.rampLowCut(coefficients.lowCut, length);
+            if( changedBands & (1 << ChainPositions::Peak) )
+                filterEngine.rampPeak(coefficients.peak, length);
+            if( changedBands & (1 << ChainPositions::HighCut) )
+                filterEngine.rampHighCut(coefficients.highCut, length);
+        }
+        
+        auto subBlock = block.getSubBlock(start, length);
+        juce::dsp::ProcessContextReplacing<float> context(subBlock);
+        filterEngine.process(context);
+    }
 }
 
-void SimpleEQAudioProcessor::updateFilters()
+void SimpleEQAudioProcessor::finishSmoothing()
 {
-    auto chainSettings = getChainSettings(apvts);
-    updateLowCutFilters(chainSettings);
-    updatePeakFilter(chainSettings);
-    updateHighCutFilters(chainSettings);
+    const auto& coefficients = coefficientDesigner.getCoefficients();
+    
+    for( int band = 0; band < NumChainPositions; ++band )
+        smoother.jumpTo(coefficients, band);
+    
+    updateLowCutFilters(coefficients);
+    updatePeakFilter(coefficients);
+    updateHighCutFilters(coefficients);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::CreateParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowCut Freq", 1),
-                                                           "LowCut Freq",
-                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
-                                                           MIN_FREQUENCY));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighCut Freq", 1),
-                                                           "HighCut Freq",
-                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
-                                                           MAX_FREQUENCY));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Freq", 1),
-                                                           "Peak Freq",
-                                                           juce::NormalisableRange<float>(MIN_FREQUENCY, MAX_FREQUENCY, 1.f, 0.25f),
-                                                           750.f));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Gain", 1),
-                                                           "Peak Gain",
-                                                           juce::NormalisableRange<float>(MIN_GAIN, MAX_GAIN, 1.f, 1.f),
-                                                           0.f));
-    
-    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Peak Quality", 1),
-                                                           "Peak Quality",
-                                                           juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
-                                                           1.f));
-    
-    juce::StringArray stringArray;
-    for (int i = 0; i < 4; ++i) {
-        juce::String str;
-        str << (12 + i * 12);
-        str << " db/Oct";
-        stringArray.add(str);
-    }
-    
-    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("LowCut Slope", 1), "LowCut Slope", stringArray, 0));
-    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("HighCut Slope", 1), "HighCut Slope", stringArray, 0));
-        
-    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("LowCut Bypassed", 1), "LowCut Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Peak Bypassed", 1), "Peak Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("HighCut Bypassed", 1), "HighCut Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Analyzer Enabled", 1), "Analyser Enabled", true));
-    
-    return layout;
+    return createParameterLayout();
 }
 
 //==============================================================================
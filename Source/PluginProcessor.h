@@ -10,96 +10,10 @@
 
 #include <JuceHeader.h>
 #include "DSP/SingleChannelSampleFifo.h"
-
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-struct ChainSettings
-{
-    float peakFreq { 0 }, peakGainInDecibels { 0 }, peakQuality { 1.f };
-    float lowCutFreq { 0 }, highCutFreq { 0 };
-    Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
-    bool lowCutBypassed { false }, peakBypassed { false }, highCutBypassed { false }, analyzerEnabled { true };
-};
-
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
-
-using Filter = juce::dsp::IIR::Filter<float>;
-// 1 Filter = 12db so using 4 to get 48db
-using Cutfilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-// Lowcut 48db, Peakfilter 12db, HighCut 48db
-using MonoChain = juce::dsp::ProcessorChain<Cutfilter, Filter, Cutfilter>;
-
-enum ChainPositions
-{
-    LowCut,
-    Peak,
-    HighCut
-};
-
-using Coefficients = Filter::CoefficientsPtr;
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate);
-
-template<int Index, typename ChainType, typename CoefficientType>
-void update(ChainType& chain, const CoefficientType& coefficients)
-{
-    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
-    chain.template setBypassed<Index>(false);
-};
-
-template<typename ChainType, typename CoefficientType>
-void updateCutFilter(ChainType& leftLowCut,
-                     const CoefficientType& cutCoefficients,
-                     const Slope& lowCutSlope)
-{
-    
-    leftLowCut.template setBypassed<0>(true);
-    leftLowCut.template setBypassed<1>(true);
-    leftLowCut.template setBypassed<2>(true);
-    leftLowCut.template setBypassed<3>(true);
-
-    switch( lowCutSlope )
-    {
-        case Slope_48:
-        {
-            update<3>(leftLowCut, cutCoefficients);
-        }
-        case Slope_36:
-        {
-            update<2>(leftLowCut, cutCoefficients);
-        }
-        case Slope_24:
-        {
-            update<1>(leftLowCut, cutCoefficients);
-        }
-        case Slope_12:
-        {
-            update<0>(leftLowCut, cutCoefficients);
-        }
-    }
-}
-
-inline auto makeLowCutFilter(const ChainSettings& chainSettings, double samplerate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
-                                                                                samplerate,
-                                                                                2 * (chainSettings.lowCutSlope + 1));
-}
-
-inline auto makeHighCutFilter(const ChainSettings& chainSettings, double samplerate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
-                                                                                samplerate,
-                                                                                2 * (chainSettings.lowCutSlope + 1));
-}
-
+#include "DSP/ChainSettings.h"
+#include "DSP/CoefficientDesigner.h"
+#include "DSP/CoefficientSmoother.h"
+#include "DSP/SIMDFilterEngine.h"
 
 //==============================================================================
 /**
@@ -155,13 +69,25 @@ public:
     SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
     
 private:
-    MonoChain leftChain, rightChain;
+    SIMDFilterEngine filterEngine;
     
-    void updatePeakFilter(const ChainSettings& chainSettings);
-    void updateLowCutFilters(const ChainSettings& chainSettings);
-    void updateHighCutFilters(const ChainSettings& chainSettings);
+    CoefficientDesigner coefficientDesigner { apvts };
+    juce::SharedResourcePointer<CutCoefficientTableCache> cutCoefficientTables;
+    std::array<juce::uint32, NumChainPositions> appliedBandVersions {};
+    
+    CoefficientSmoother smoother;
+    std::atomic<float>* smoothingParameter { apvts.getRawParameterValue("Smoothing") };
+    
+    void updatePeakFilter(const FilterCoefficients& coefficients);
+    void updateLowCutFilters(const FilterCoefficients& coefficients);
+    void updateHighCutFilters(const FilterCoefficients& coefficients);
     
     void updateFilters();
+    
+    /** samples between two redesigns while gliding, 0 when smoothing is off. */
+    int getSmoothingInterval() const;
+    void processSmoothed(juce::dsp::AudioBlock<float>& block, int interval);
+    void finishSmoothing();
      
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
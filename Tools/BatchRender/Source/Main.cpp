@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 3:48:10pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PresetHost.h"
+#include "RenderJob.h"
+#include "../../../Source/DSP/FrequencyResponse.h"
+#include "../../../Source/DSP/ParameterRanges.h"
+
+namespace
+{
+constexpr int DefaultBlockSize = 65536;
+constexpr double DefaultResponseSampleRate = 48000.0;
+constexpr int DefaultResponsePoints = 512;
+
+void printUsage()
+{
+    std::cout << "Renders audio files through SimpleEQ's filters.\n\n"
+                 "usage: BatchRender --preset <file> --output <folder> [--threads <n>] [--block-size <n>] <files or folders...>\n"
+                 "       BatchRender --preset <file> --response <file> [--sample-rate <hz>] [--points <n>]\n\n"
+                 "  --preset       state saved by the plugin (binary or xml)\n"
+                 "  --output       where the rendered files go, same names and formats as the inputs,\n"
+                 "                 numbered where inputs from different folders share a name\n"
+                 "  --threads      files rendered at once, defaults to the number of cpus\n"
+                 "  --block-size   samples read and processed at a time, defaults to " << DefaultBlockSize << "\n"
+                 "  --response     writes the preset's magnitude, phase and group delay to a csv file\n"
+                 "  --sample-rate  the response's sample rate, defaults to " << DefaultResponseSampleRate << "\n"
+                 "  --points       log spaced frequencies from " << MIN_FREQUENCY << " Hz to " << MAX_FREQUENCY / 1000.f << " kHz, the editor's range,\n"
+                 "                 defaults to " << DefaultResponsePoints << std::endl;
+}
+
+bool writeResponse(const ChainSettings& chainSettings, const juce::File& file, double sampleRate, int numPoints)
+{
+    FrequencyResponseEngine engine;
+    engine.setLogFrequencies(numPoints, MIN_FREQUENCY, MAX_FREQUENCY, sampleRate);
+
+    FrequencyResponse response;
+    engine.process(chainSettings, response);
+
+    juce::String csv("frequency_hz,magnitude_db,phase_rad,group_delay_s\n");
+    for( int i = 0; i < response.size(); ++i )
+    {
+        const auto index = static_cast<size_t>(i);
+        csv << engine.getFrequency(i) << ","
+            << response.magnitudeInDecibels[index] << ","
+            << response.phaseInRadians[index] << ","
+            << response.groupDelayInSeconds[index] << "\n";
+    }
+
+    return file.replaceWithText(csv);
+}
+
+/** options take the next argument as their value, everything else is an input file or folder. */
+juce::Array<juce::File> collectInputs(const juce::ArgumentList& args)
+{
+    juce::Array<juce::File> inputs;
+
+    for( int i = 0; i < args.size(); ++i )
+    {
+        if( args[i].isLongOption() )
+        {
+            if( ! args[i].text.contains("=") )
+                ++i;
+
+            continue;
+        }
+
+        auto file = args[i].resolveAsFile();
+
+        if( file.isDirectory() )
+        {
+            for( const auto& entry : juce::RangedDirectoryIterator(file, false, "*.wav;*.aif;*.aiff") )
+                inputs.addIfNotAlreadyThere(entry.getFile());
+        }
+        else
+        {
+            inputs.addIfNotAlreadyThere(file);
+        }
+    }
+
+    return inputs;
+}
+
+/**
+ where each input gets rendered to. inputs from different folders can have the same name,
+ the later ones get a number added, so no two jobs ever write the same file.
+ */
+juce::Array<juce::File> getOutputFiles(const juce::Array<juce::File>& inputs, const juce::File& outputFolder)
+{
+    juce::Array<juce::File> outputs;
+
+    // not every file system tells case apart
+    std::set<juce::String> usedNames;
+
+    for( const auto& input : inputs )
+    {
+        auto name = input.getFileName();
+        for( int n = 2; usedNames.count(name.toLowerCase()) > 0; ++n )
+            name = input.getFileNameWithoutExtension() + " " + juce::String(n) + input.getFileExtension();
+
+        if( name != input.getFileName() )
+            std::cout << input.getFullPathName() << " goes to " << name << ", its name is taken" << std::endl;
+
+        usedNames.insert(name.toLowerCase());
+        outputs.add(outputFolder.getChildFile(name));
+    }
+
+    return outputs;
+}
+
+juce::int64 getTotalNumSamples(const juce::Array<juce::File>& inputs)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    juce::int64 total = 0;
+    for( const auto& input : inputs )
+    {
+        if( std::unique_ptr<juce::AudioFormatReader> reader { formatManager.createReaderFor(input) } )
+            total += reader->lengthInSamples;
+    }
+
+    return total;
+}
+
+void printProgress(const RenderProgress& progress, int numFiles, juce::int64 totalNumSamples, double seconds)
+{
+    auto rendered = progress.samplesRendered.load();
+    auto percent = totalNumSamples > 0 ? 100.0 * static_cast<double>(rendered) / static_cast<double>(totalNumSamples) : 100.0;
+    auto samplesPerSecond = seconds > 0 ? static_cast<double>(rendered) / seconds : 0.0;
+
+    std::cout << "\r" << (progress.filesFinished + progress.filesFailed) << "/" << numFiles << " files, "
+              << juce::String(percent, 1) << "%, "
+              << juce::String(samplesPerSecond / 1.0e6, 2) << " M samples/s   " << std::flush;
+}
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // the APVTS needs a message manager for its timer
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    if( ! args.containsOption("--preset") || ! (args.containsOption("--output") || args.containsOption("--response")) )
+    {
+        printUsage();
+        return 1;
+    }
+
+    PresetHost presetHost;
+    auto presetFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--preset"));
+    if( ! presetHost.loadPreset(presetFile) )
+    {
+        std::cerr << "can't load the preset " << presetFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if( args.containsOption("--response") )
+    {
+        auto sampleRate = args.containsOption("--sample-rate")
+                        ? args.getValueForOption("--sample-rate").getDoubleValue()
+                        : DefaultResponseSampleRate;
+        auto numPoints = args.containsOption("--points")
+                       ? args.getValueForOption("--points").getIntValue()
+                       : DefaultResponsePoints;
+
+        if( sampleRate <= 0 || numPoints < 1 )
+        {
+            printUsage();
+            return 1;
+        }
+
+        auto responseFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--response"));
+        if( ! writeResponse(presetHost.getChainSettings(), responseFile, sampleRate, numPoints) )
+        {
+            std::cerr << "can't write " << responseFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        // only the response was asked for
+        if( ! args.containsOption("--output") )
+            return 0;
+    }
+
+    auto outputFolder = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+    if( ! outputFolder.createDirectory() )
+    {
+        std::cerr << "can't create " << outputFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    auto numThreads = args.containsOption("--threads")
+                    ? args.getValueForOption("--threads").getIntValue()
+                    : juce::SystemStats::getNumCpus();
+    auto blockSize = args.containsOption("--block-size")
+                   ? args.getValueForOption("--block-size").getIntValue()
+                   : DefaultBlockSize;
+
+    auto inputs = collectInputs(args);
+    if( inputs.isEmpty() || numThreads < 1 || blockSize < 1 )
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto chainSettings = presetHost.getChainSettings();
+    const auto totalNumSamples = getTotalNumSamples(inputs);
+    const auto outputs = getOutputFiles(inputs, outputFolder);
+
+    RenderProgress progress;
+    juce::OwnedArray<RenderJob> jobs;
+    juce::ThreadPool pool(numThreads);
+
+    for( int i = 0; i < inputs.size(); ++i )
+    {
+        auto* job = jobs.add(new RenderJob(inputs[i],
+                                           outputs[i],
+                                           chainSettings,
+                                           blockSize,
+                                           progress));
+        pool.addJob(job, false);
+    }
+
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+    auto getElapsedSeconds = [startTime] { return (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0; };
+
+    while( pool.getNumJobs() > 0 )
+    {
+        printProgress(progress, inputs.size(), totalNumSamples, getElapsedSeconds());
+        juce::Thread::sleep(250);
+    }
+
+    printProgress(progress, inputs.size(), totalNumSamples, getElapsedSeconds());
+    std::cout << std::endl;
+
+    for( auto* job : jobs )
+    {
+        if( job->getError().isNotEmpty() )
+            std::cerr << job->getInput().getFullPathName() << ": " << job->getError() << std::endl;
+    }
+
+    return progress.filesFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    PresetHost.cpp
+    Created: 17 Oct 2026 3:48:10pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "PresetHost.h"
+
+bool PresetHost::loadPreset(const juce::File& file)
+{
+    juce::MemoryBlock data;
+    if( ! file.loadFileAsData(data) )
+        return false;
+
+    auto tree = juce::ValueTree::readFromData(data.getData(), data.getSize());
+
+    if( ! tree.isValid() )
+    {
+        if( auto xml = juce::parseXML(data.toString()) )
+            tree = juce::ValueTree::fromXml(*xml);
+    }
+
+    if( ! tree.hasType(apvts.state.getType()) )
+        return false;
+
+    apvts.replaceState(tree);
+    return true;
+}
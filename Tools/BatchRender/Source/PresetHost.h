@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    PresetHost.h
+    Created: 17 Oct 2026 3:48:10pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/ChainSettings.h"
+
+/**
+ Just enough of an AudioProcessor to own an APVTS with the plugin's parameters,
+ so a preset loads exactly like it does in SimpleEQAudioProcessor::setStateInformation(),
+ defaults for missing parameters included.
+ */
+struct PresetHost : juce::AudioProcessor
+{
+    /** reads the binary state the plugin writes in getStateInformation(), or the same tree as xml. */
+    bool loadPreset(const juce::File& file);
+
+    ChainSettings getChainSettings() { return ::getChainSettings(apvts); }
+
+    juce::AudioProcessorValueTreeState apvts { *this, nullptr, "Parameters", createParameterLayout() };
+
+    //==============================================================================
+    const juce::String getName() const override { return "PresetHost"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+};
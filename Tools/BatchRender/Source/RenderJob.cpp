@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    RenderJob.cpp
+    Created: 17 Oct 2026 3:48:10pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "RenderJob.h"
+#include "../../../Source/DSP/SIMDFilterEngine.h"
+
+RenderJob::RenderJob(const juce::File& inputFile,
+                     const juce::File& outputFile,
+                     const ChainSettings& settings,
+                     int samplesPerBlock,
+                     RenderProgress& renderProgress) :
+juce::ThreadPoolJob(inputFile.getFileName()),
+input(inputFile),
+output(outputFile),
+chainSettings(settings),
+blockSize(samplesPerBlock),
+progress(renderProgress)
+{
+}
+
+juce::ThreadPoolJob::JobStatus RenderJob::runJob()
+{
+    error = render();
+
+    if( error.isEmpty() )
+        ++progress.filesFinished;
+    else
+        ++progress.filesFailed;
+
+    return jobHasFinished;
+}
+
+juce::String RenderJob::render()
+{
+    // every job has its own, they're cheap and not thread safe
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if( reader == nullptr )
+        return "can't read the file";
+
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    if( numChannels > static_cast<int>(SIMDFilterEngine::MaxChannels) )
+        return "more than " + juce::String(static_cast<int>(SIMDFilterEngine::MaxChannels)) + " channels";
+
+    auto* format = formatManager.findFormatForFileExtension(output.getFileExtension());
+    if( format == nullptr )
+        return "no format for " + output.getFileExtension();
+
+    if( output == input )
+        return "the output would overwrite the input";
+
+    output.deleteFile();
+    auto stream = output.createOutputStream();
+    if( stream == nullptr )
+        return "can't create " + output.getFullPathName();
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                            reader->sampleRate,
+                                                                            reader->numChannels,
+                                                                            static_cast<int>(reader->bitsPerSample),
+                                                                            reader->metadataValues,
+                                                                            0));
+    if( writer == nullptr )
+        return "can't write " + format->getFormatName() + " with these settings";
+
+    // the writer owns the stream now
+    stream.release();
+
+    SIMDFilterEngine filterEngine;
+    filterEngine.prepare({ reader->sampleRate,
+                           static_cast<juce::uint32>(blockSize),
+                           static_cast<juce::uint32>(numChannels) });
+    filterEngine.update(chainSettings, reader->sampleRate);
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+
+    for( juce::int64 position = 0; position < reader->lengthInSamples; )
+    {
+        if( shouldExit() )
+            return "cancelled";
+
+        auto numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize),
+                                                      reader->lengthInSamples - position));
+
+        if( ! reader->read(&buffer, 0, numSamples, position, true, true) )
+            return "read error at sample " + juce::String(position);
+
+        auto block = juce::dsp::AudioBlock<float>(buffer).getSubBlock(0, static_cast<size_t>(numSamples));
+        filterEngine.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+        if( ! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples) )
+            return "write error at sample " + juce::String(position);
+
+        position += numSamples;
+        progress.samplesRendered += numSamples;
+    }
+
+    return {};
+}
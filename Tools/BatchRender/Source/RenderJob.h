@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    RenderJob.h
+    Created: 17 Oct 2026 3:48:10pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/ChainSettings.h"
+
+/** shared by every job, read by the progress display. */
+struct RenderProgress
+{
+    std::atomic<juce::int64> samplesRendered { 0 };
+    std::atomic<int> filesFinished { 0 };
+    std::atomic<int> filesFailed { 0 };
+};
+
+/**
+ Runs one file through the plugin's filters: reads it in large blocks, processes
+ them with a SIMDFilterEngine and writes the result in the same format,
+ sample rate, channel count and bit depth.
+ */
+class RenderJob : public juce::ThreadPoolJob
+{
+public:
+    RenderJob(const juce::File& input,
+              const juce::File& output,
+              const ChainSettings& chainSettings,
+              int blockSize,
+              RenderProgress& progress);
+
+    JobStatus runJob() override;
+
+    const juce::File& getInput() const { return input; }
+    /** empty if the file rendered fine. */
+    const juce::String& getError() const { return error; }
+private:
+    juce::String render();
+
+    juce::File input, output;
+    ChainSettings chainSettings;
+    int blockSize;
+    RenderProgress& progress;
+    juce::String error;
+};
@@ -0,0 +1,617 @@
+/*
+  ==============================================================================
+
+    AnalyzerBenchmarks.cpp
+    Created: 17 Oct 2026 4:30:52pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "FFTDataGenerator.h"
+#include "../../../Source/GUI/MultiResolutionAnalyzer.h"
+#include "../../../Source/GUI/AnalyzerPathGenerator.h"
+#include "../../../Source/GUI/Spectrogram.h"
+#include "../../../Source/GUI/Utilities.h"
+#include "../../../Source/DSP/ChainSettings.h"
+#include "../../../Source/DSP/CoefficientDesigner.h"
+#include "../../../Source/GUI/SpectrumKernels.h"
+#include "../../../Source/GUI/SpectrumAverager.h"
+#include "../../../Source/DSP/SingleChannelSampleFifo.h"
+#include "../../../Source/DSP/FrequencyResponse.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr float NegativeInfinity = -48.f;
+
+// about what the editor's analysis area is at its default size
+const juce::Rectangle<float> FFTBounds { 0.f, 0.f, 560.f, 220.f };
+
+void runFFTBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    for( auto order : { FFTOrder::order2048, FFTOrder::order4096, FFTOrder::order8192 } )
+    {
+        FFTDataGenerator<std::vector<float>> fftDataGenerator;
+        fftDataGenerator.changeOrder(order);
+
+        const auto fftSize = fftDataGenerator.getFFTSize();
+        const auto binWidth = static_cast<float>(SampleRate / fftSize);
+
+        juce::AudioBuffer<float> audio(1, fftSize);
+        juce::Random random;
+        for( int i = 0; i < fftSize; ++i )
+            audio.setSample(0, i, random.nextFloat() - 0.5f);
+
+        std::vector<float> fftData;
+
+        // releasing straight away keeps the fifo from filling up, like the PathProducer does
+        auto fftResult = runner.run("analyzer", "produceFFTDataForRendering, " + juce::String(fftSize), fftSize, [&]
+        {
+            fftDataGenerator.produceFFTDataForRendering(audio, NegativeInfinity);
+            if( fftDataGenerator.acquireFFTData() != nullptr )
+                fftDataGenerator.releaseFFTData();
+        });
+        
+        // one frame to draw from, kept outside the fifo
+        fftDataGenerator.produceFFTDataForRendering(audio, NegativeInfinity);
+        if( auto* frame = fftDataGenerator.acquireFFTData() )
+        {
+            fftData = *frame;
+            fftDataGenerator.releaseFFTData();
+        }
+        fftResult.parameters.set("fftSize", fftSize);
+        results.add(fftResult);
+
+        AnalyzerPathGenerator<juce::Path> pathGenerator;
+        juce::Path path;
+
+        auto pathResult = runner.run("analyzer", "generatePath, " + juce::String(fftSize), fftSize / 2, [&]
+        {
+            pathGenerator.generatePath(fftData, FFTBounds, fftSize, binWidth, NegativeInfinity);
+            pathGenerator.getPath(path);
+        });
+        pathResult.parameters.set("fftSize", fftSize);
+        pathResult.parameters.set("width", FFTBounds.getWidth());
+        results.add(pathResult);
+    }
+}
+
+/** both analyzer channels per frame: two real FFTs against one complex FFT, and the mono sum. */
+void runStereoFFTBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    using SampleFifo = SingleChannelSampleFifo<juce::AudioBuffer<float>>;
+
+    for( auto order : { FFTOrder::order2048, FFTOrder::order4096, FFTOrder::order8192 } )
+    {
+        FFTDataGenerator<std::vector<float>> fftDataGenerator;
+        fftDataGenerator.changeOrder(order);
+
+        const auto fftSize = fftDataGenerator.getFFTSize();
+
+        juce::AudioBuffer<float> audio(2, fftSize);
+        juce::Random random;
+        for( int channel = 0; channel < 2; ++channel )
+            for( int i = 0; i < fftSize; ++i )
+                audio.setSample(channel, i, random.nextFloat() - 0.5f);
+
+        SampleFifo left(Channel::Left), right(Channel::Right);
+        left.prepare(fftSize);
+        right.prepare(fftSize);
+        left.update(audio);
+        right.update(audio);
+
+        const auto end = left.getWritePosition();
+
+        auto releaseAll = [&]
+        {
+            for( int output = 0; output < FFTDataGenerator<std::vector<float>>::NumOutputs; ++output )
+                while( fftDataGenerator.acquireFFTData(output) != nullptr )
+                    fftDataGenerator.releaseFFTData(output);
+        };
+
+        auto addResult = [&](const juce::String& name, std::function<void()> fn)
+        {
+            auto result = runner.run("analyzer", name + ", " + juce::String(fftSize), fftSize, fn);
+            result.parameters.set("fftSize", fftSize);
+            results.add(result);
+        };
+
+        addResult("stereo, two real FFTs", [&]
+        {
+            fftDataGenerator.produceFFTDataForRendering(left, end, NegativeInfinity);
+            releaseAll();
+            fftDataGenerator.produceFFTDataForRendering(right, end, NegativeInfinity);
+            releaseAll();
+        });
+
+        addResult("stereo, one complex FFT", [&]
+        {
+            fftDataGenerator.produceFFTDataForRendering(left, right, end, NegativeInfinity, AnalyzerMode::LeftRight);
+            releaseAll();
+        });
+
+        addResult("mono sum", [&]
+        {
+            fftDataGenerator.produceFFTDataForRendering(left, right, end, NegativeInfinity, AnalyzerMode::MonoSum);
+            releaseAll();
+        });
+    }
+}
+
+/**
+ the cost per input sample of keeping both channels analyzed at 50% overlap:
+ one 8192 point FFT per hop against the multi-resolution analyzer, decimation included.
+ and then drawing the stitched frame.
+ */
+void runMultiResolutionBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    using SampleFifo = SingleChannelSampleFifo<juce::AudioBuffer<float>>;
+
+    AnalyzerSettings settings;
+    settings.overlap = AnalyzerOverlap::Overlap_50;
+
+    {
+        FFTDataGenerator<std::vector<float>> fftDataGenerator;
+        fftDataGenerator.changeOrder(FFTOrder::order8192);
+
+        const auto fftSize = fftDataGenerator.getFFTSize();
+
+        juce::AudioBuffer<float> audio(2, fftSize);
+        juce::Random random;
+        for( int channel = 0; channel < 2; ++channel )
+            for( int i = 0; i < fftSize; ++i )
+                audio.setSample(channel, i, random.nextFloat() - 0.5f);
+
+        SampleFifo left(Channel::Left), right(Channel::Right);
+        left.prepare(fftSize);
+        right.prepare(fftSize);
+        left.update(audio);
+        right.update(audio);
+
+        const auto end = left.getWritePosition();
+
+        auto result = runner.run("analyzer", "single resolution, 8192", settings.getHopSize(fftSize), [&]
+        {
+            fftDataGenerator.produceFFTDataForRendering(left, right, end, NegativeInfinity, AnalyzerMode::LeftRight);
+            for( int output = 0; output < FFTDataGenerator<std::vector<float>>::NumOutputs; ++output )
+                if( fftDataGenerator.acquireFFTData(output) != nullptr )
+                    fftDataGenerator.releaseFFTData(output);
+        });
+        result.parameters.set("fftSize", fftSize);
+        results.add(result);
+    }
+
+    for( auto order : { FFTOrder::order8192, FFTOrder::order16384, FFTOrder::order32768 } )
+    {
+        MultiResolutionAnalyzer analyzer;
+        analyzer.prepare();
+
+        settings.order = order;
+        analyzer.reset(SampleRate, settings, NegativeInfinity);
+
+        constexpr int BlockSize = 1024;
+        std::vector<float> noise(2 * BlockSize), left(BlockSize), right(BlockSize);
+        juce::Random random;
+        for( auto& v : noise )
+            v = random.nextFloat() - 0.5f;
+
+        const auto equivalentSize = 1 << static_cast<int>(order);
+
+        // pushSamples() works in place, so every call gets a fresh copy
+        auto result = runner.run("analyzer", "multi-resolution, " + juce::String(equivalentSize), BlockSize, [&]
+        {
+            std::copy(noise.begin(), noise.begin() + BlockSize, left.begin());
+            std::copy(noise.begin() + BlockSize, noise.end(), right.begin());
+
+            analyzer.pushSamples(left.data(), right.data(), BlockSize);
+            analyzer.analyze(settings);
+        });
+        result.parameters.set("fftSize", equivalentSize);
+        result.parameters.set("numBands", static_cast<int>(analyzer.getBands().size()));
+        results.add(result);
+
+        const std::vector<float> frame(analyzer.getFrame(0));
+        AnalyzerPathGenerator<juce::Path> pathGenerator;
+        juce::Path path;
+
+        auto pathResult = runner.run("analyzer", "generatePath, multi-resolution, " + juce::String(equivalentSize), analyzer.getFrameSize(), [&]
+        {
+            pathGenerator.generatePath(frame, FFTBounds, analyzer.getBands(), NegativeInfinity);
+            pathGenerator.getPath(path);
+        });
+        pathResult.parameters.set("fftSize", equivalentSize);
+        pathResult.parameters.set("width", FFTBounds.getWidth());
+        results.add(pathResult);
+
+        // a frame into a row, colouring the row and writing it into the history, which shouldn't depend on how long that is
+        SpectrogramGenerator spectrogramGenerator;
+        SpectrogramImage spectrogramImage;
+        SpectrogramRow row;
+        const auto width = static_cast<int>(FFTBounds.getWidth());
+        const auto samplesPerRow = static_cast<int>(SampleRate) / SpectrogramGenerator::RowsPerSecond;
+
+        auto rowResult = runner.run("analyzer", "spectrogram row, multi-resolution, " + juce::String(equivalentSize), width, [&]
+        {
+            spectrogramGenerator.addFrame(frame.data(), frame.data(), analyzer.getBands(), width, NegativeInfinity);
+            spectrogramGenerator.advance(samplesPerRow, SampleRate);
+            spectrogramGenerator.getRow(row);
+            spectrogramImage.addRow(row);
+        });
+        rowResult.parameters.set("fftSize", equivalentSize);
+        rowResult.parameters.set("width", width);
+        rowResult.parameters.set("numRows", SpectrogramGenerator::NumRows);
+        results.add(rowResult);
+    }
+}
+
+/** the post FFT conversion to decibels, scalar against SIMD, and how far apart they come out. */
+void runDecibelBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    for( int numBins : { 1024, 2048, 4096 } )
+    {
+        std::vector<float> magnitudes(static_cast<size_t>(numBins)), work;
+        juce::Random random;
+        for( auto& m : magnitudes )
+            m = std::pow(10.f, random.nextFloat() * 8.f - 6.f) * float(numBins);
+
+        const auto scale = 1.f / float(numBins);
+
+        std::vector<float> reference(magnitudes), fast(magnitudes);
+        magnitudesToDecibelsReference(reference.data(), numBins, scale, NegativeInfinity);
+        magnitudesToDecibels(fast.data(), numBins, scale, NegativeInfinity);
+
+        float maxError = 0.f;
+        for( int i = 0; i < numBins; ++i )
+            maxError = juce::jmax(maxError, std::abs(fast[i] - reference[i]));
+
+        // both work in place, so each call starts from a fresh copy. that's in both timings alike.
+        auto scalarResult = runner.run("analyzer", "magnitudesToDecibels scalar, " + juce::String(numBins), numBins, [&]
+        {
+            work = magnitudes;
+            magnitudesToDecibelsReference(work.data(), numBins, scale, NegativeInfinity);
+        });
+        scalarResult.parameters.set("numBins", numBins);
+        results.add(scalarResult);
+
+        auto simdResult = runner.run("analyzer", "magnitudesToDecibels SIMD, " + juce::String(numBins), numBins, [&]
+        {
+            work = magnitudes;
+            magnitudesToDecibels(work.data(), numBins, scale, NegativeInfinity);
+        });
+        simdResult.parameters.set("numBins", numBins);
+        simdResult.parameters.set("maxErrorDb", maxError);
+        results.add(simdResult);
+    }
+}
+
+/**
+ one frame through the averaging and peak hold stage, per averaging mode. every band
+ of the multi-resolution frame has a new FFT, which is as much as one call ever does.
+ */
+void runAveragingBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    const std::pair<AnalyzerAveraging, const char*> modes[]
+    {
+        { AnalyzerAveraging::NoAveraging, "off" },
+        { AnalyzerAveraging::ExponentialAveraging, "exponential" },
+        { AnalyzerAveraging::WelchAveraging, "Welch" }
+    };
+
+    for( auto order : { FFTOrder::order8192, FFTOrder::order32768 } )
+    {
+        MultiResolutionAnalyzer analyzer;
+        analyzer.prepare();
+
+        AnalyzerSettings analyzerSettings;
+        analyzerSettings.order = order;
+        analyzer.reset(SampleRate, analyzerSettings, NegativeInfinity);
+
+        SpectrumAverager averager;
+        averager.prepare(MultiResolutionAnalyzer::getMaxFrameSize(), MultiResolutionAnalyzer::MaxNumBands);
+        averager.setBands(analyzer.getBands());
+
+        std::vector<float> frame(analyzer.getFrame(0));
+        juce::Random random;
+        for( auto& v : frame )
+            v = NegativeInfinity * random.nextFloat();
+
+        std::array<bool, MultiResolutionAnalyzer::MaxNumBands> newBands;
+        newBands.fill(true);
+
+        const auto numBins = analyzer.getFrameSize();
+        const auto equivalentSize = 1 << static_cast<int>(order);
+
+        for( const auto& [averaging, name] : modes )
+        {
+            for( bool peakHold : { false, true } )
+            {
+                AnalyzerSettings settings;
+                settings.averaging = averaging;
+                settings.response = AnalyzerResponse::Response_Slow;
+                settings.peakHold = peakHold;
+
+                averager.reset();
+
+                auto label = juce::String("averaging ") + name + (peakHold ? " + peak hold, " : ", ") + juce::String(equivalentSize);
+                auto result = runner.run("analyzer", label, numBins, [&]
+                {
+                    averager.process(frame.data(), newBands.data(), settings, 1.f / 60.f);
+                });
+                result.parameters.set("fftSize", equivalentSize);
+                result.parameters.set("numBins", numBins);
+                result.parameters.set("averaging", name);
+                result.parameters.set("peakHold", peakHold);
+                results.add(result);
+            }
+        }
+    }
+}
+
+// the juce::dsp chain the editor used to draw its response curve with, only the baseline below needs it now
+using Filter = juce::dsp::IIR::Filter<float>;
+// 1 Filter = 12db so using 4 to get 48db
+using Cutfilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+// Lowcut 48db, Peakfilter 12db, HighCut 48db
+using MonoChain = juce::dsp::ProcessorChain<Cutfilter, Filter, Cutfilter>;
+
+using Coefficients = Filter::CoefficientsPtr;
+
+void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+{
+    *old = *replacements;
+}
+
+Coefficients makePeakFilter(const ChainSettings& chainSettings, double samplerate)
+{
+    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(samplerate,
+                                                        chainSettings.peakFreq,
+                                                        chainSettings.peakQuality,
+                                                        juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+}
+
+template<int Index, typename ChainType, typename CoefficientType>
+void update(ChainType& chain, const CoefficientType& coefficients)
+{
+    updateCoefficients(chain.template get<Index>().coefficients, coefficients[Index]);
+    chain.template setBypassed<Index>(false);
+}
+
+template<typename ChainType, typename CoefficientType>
+void updateCutFilter(ChainType& leftLowCut,
+                     const CoefficientType& cutCoefficients,
+                     const Slope& lowCutSlope)
+{
+    leftLowCut.template setBypassed<0>(true);
+    leftLowCut.template setBypassed<1>(true);
+    leftLowCut.template setBypassed<2>(true);
+    leftLowCut.template setBypassed<3>(true);
+
+    switch( lowCutSlope )
+    {
+        case Slope_48:
+        {
+            update<3>(leftLowCut, cutCoefficients);
+        }
+        case Slope_36:
+        {
+            update<2>(leftLowCut, cutCoefficients);
+        }
+        case Slope_24:
+        {
+            update<1>(leftLowCut, cutCoefficients);
+        }
+        case Slope_12:
+        {
+            update<0>(leftLowCut, cutCoefficients);
+        }
+    }
+}
+
+auto makeLowCutFilter(const ChainSettings& chainSettings, double samplerate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq,
+                                                                                samplerate,
+                                                                                2 * (chainSettings.lowCutSlope + 1));
+}
+
+auto makeHighCutFilter(const ChainSettings& chainSettings, double samplerate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq,
+                                                                                samplerate,
+                                                                                2 * (chainSettings.highCutSlope + 1));
+}
+
+/**
+ the per frequency, per biquad evaluation of a juce::dsp chain the FrequencyResponseEngine
+ replaced in the editor, kept here as the baseline it gets timed against.
+ */
+void updateResponseBand(MonoChain& chain, ChainPositions band, const ChainSettings& chainSettings, double sampleRate)
+{
+    switch( band )
+    {
+        case ChainPositions::LowCut:
+        {
+            chain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+            auto lowCutCoefficients = makeLowCutFilter(chainSettings, sampleRate);
+            updateCutFilter(chain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
+            break;
+        }
+        case ChainPositions::Peak:
+        {
+            chain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+            auto peakCoefficients = makePeakFilter(chainSettings, sampleRate);
+            updateCoefficients(chain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+            break;
+        }
+        case ChainPositions::HighCut:
+        {
+            chain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+            auto highCutCoefficients = makeHighCutFilter(chainSettings, sampleRate);
+            updateCutFilter(chain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+            break;
+        }
+        default:
+            jassertfalse;
+            break;
+    }
+}
+
+/** sets the whole chain up from the settings, it only gets evaluated, never processes audio. */
+void updateResponseChain(MonoChain& chain, const ChainSettings& chainSettings, double sampleRate)
+{
+    for( int band = 0; band < NumChainPositions; ++band )
+        updateResponseBand(chain, static_cast<ChainPositions>(band), chainSettings, sampleRate);
+}
+
+template<typename CutChain>
+double getCutMagnitude(const CutChain& cut, double freq, double samplerate)
+{
+    double mag = 1.f;
+
+    if(!cut.template isBypassed<0>())
+        mag *= cut.template get<0>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+    if(!cut.template isBypassed<1>())
+        mag *= cut.template get<1>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+    if(!cut.template isBypassed<2>())
+        mag *= cut.template get<2>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+    if(!cut.template isBypassed<3>())
+        mag *= cut.template get<3>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+
+    return mag;
+}
+
+/** the gain of one band of the chain at freq, 1 if it's bypassed. */
+double getBandMagnitude(const MonoChain& chain, ChainPositions band, double freq, double samplerate)
+{
+    switch( band )
+    {
+        case ChainPositions::LowCut:
+            return chain.isBypassed<ChainPositions::LowCut>() ? 1.0 : getCutMagnitude(chain.get<ChainPositions::LowCut>(), freq, samplerate);
+        case ChainPositions::Peak:
+            return chain.isBypassed<ChainPositions::Peak>() ? 1.0 : chain.get<ChainPositions::Peak>().coefficients->getMagnitudeForFrequency(freq, samplerate);
+        case ChainPositions::HighCut:
+            return chain.isBypassed<ChainPositions::HighCut>() ? 1.0 : getCutMagnitude(chain.get<ChainPositions::HighCut>(), freq, samplerate);
+        default:
+            jassertfalse;
+            return 1.0;
+    }
+}
+
+/** the chain's response in decibels, at mags.size() log spaced frequencies from MIN_FREQUENCY to MAX_FREQUENCY. */
+void computeResponseMagnitudes(const MonoChain& chain, double samplerate, std::vector<double>& mags)
+{
+    using namespace juce;
+
+    const auto w = mags.size();
+
+    for (size_t i = 0; i < w; ++i) {
+        double mag = 1.f;
+        auto freq = mapToLog10(double(i) / double(w), double(MIN_FREQUENCY), double(MAX_FREQUENCY));
+
+        for( int band = 0; band < NumChainPositions; ++band )
+            mag *= getBandMagnitude(chain, static_cast<ChainPositions>(band), freq, samplerate);
+
+        mags[i] = Decibels::gainToDecibels(mag);
+    }
+}
+
+void runResponseCurveBenchmarks(const BenchmarkRunner& runner, juce::Array<BenchmarkResult>& results)
+{
+    ChainSettings chainSettings;
+    chainSettings.lowCutFreq = 80.f;
+    chainSettings.lowCutSlope = Slope_48;
+    chainSettings.peakFreq = 1000.f;
+    chainSettings.peakGainInDecibels = 6.f;
+    chainSettings.highCutFreq = 12000.f;
+    chainSettings.highCutSlope = Slope_48;
+
+    MonoChain chain;
+    updateResponseChain(chain, chainSettings, SampleRate);
+
+    const auto coefficients = designFilterCoefficients(chainSettings, SampleRate);
+
+    for( int width : { 280, 560, 1120 } )
+    {
+        std::vector<double> magnitudes(static_cast<size_t>(width));
+
+        auto result = runner.run("analyzer", "computeResponseMagnitudes, " + juce::String(width) + " pixels", width, [&]
+        {
+            computeResponseMagnitudes(chain, SampleRate, magnitudes);
+        });
+        result.parameters.set("width", width);
+        results.add(result);
+
+        FrequencyResponseEngine engine;
+        engine.setLogFrequencies(width, MIN_FREQUENCY, MAX_FREQUENCY, SampleRate);
+
+        std::vector<float> frequencies;
+        for( int i = 0; i < width; ++i )
+            frequencies.push_back(engine.getFrequency(i));
+
+        FrequencyResponse response, reference;
+        engine.process(coefficients, response);
+        computeFrequencyResponseReference(coefficients, frequencies.data(), width, reference);
+
+        // the phase only where there's something left to have one
+        float maxErrorDb = 0.f, maxPhaseError = 0.f, maxGroupDelayError = 0.f;
+        for( size_t i = 0; i < frequencies.size(); ++i )
+        {
+            maxErrorDb = juce::jmax(maxErrorDb, std::abs(response.magnitudeInDecibels[i] - reference.magnitudeInDecibels[i]));
+            maxGroupDelayError = juce::jmax(maxGroupDelayError, std::abs(response.groupDelayInSeconds[i] - reference.groupDelayInSeconds[i]));
+
+            if( reference.magnitudeInDecibels[i] > FrequencyResponseEngine::MinusInfinityDb )
+            {
+                auto phaseError = std::abs(response.phaseInRadians[i] - reference.phaseInRadians[i]);
+                maxPhaseError = juce::jmax(maxPhaseError, juce::jmin(phaseError, juce::MathConstants<float>::twoPi - phaseError));
+            }
+        }
+
+        auto referenceResult = runner.run("analyzer", "computeFrequencyResponseReference, " + juce::String(width) + " pixels", width, [&]
+        {
+            computeFrequencyResponseReference(coefficients, frequencies.data(), width, reference);
+        });
+        referenceResult.parameters.set("width", width);
+        results.add(referenceResult);
+
+        auto engineResult = runner.run("analyzer", "FrequencyResponseEngine, " + juce::String(width) + " pixels", width, [&]
+        {
+            engine.process(coefficients, response);
+        });
+        engineResult.parameters.set("width", width);
+        engineResult.parameters.set("maxErrorDb", maxErrorDb);
+        engineResult.parameters.set("maxPhaseError", maxPhaseError);
+        engineResult.parameters.set("maxGroupDelayError", maxGroupDelayError);
+        results.add(engineResult);
+
+        // what moving the peak costs, the curve keeps the cuts' responses
+        auto bandResult = runner.run("analyzer", "FrequencyResponseEngine, peak, " + juce::String(width) + " pixels", width, [&]
+        {
+            engine.process(coefficients, ChainPositions::Peak, response);
+        });
+        bandResult.parameters.set("width", width);
+        results.add(bandResult);
+
+        // a preset QA sweep designs every setting before evaluating it
+        auto settingsResult = runner.run("analyzer", "FrequencyResponseEngine, from settings, " + juce::String(width) + " pixels", width, [&]
+        {
+            engine.process(chainSettings, response);
+        });
+        settingsResult.parameters.set("width", width);
+        results.add(settingsResult);
+    }
+}
+}
+
+juce::Array<BenchmarkResult> runAnalyzerBenchmarks(const BenchmarkRunner& runner)
+{
+    juce::Array<BenchmarkResult> results;
+    runFFTBenchmarks(runner, results);
+    runStereoFFTBenchmarks(runner, results);
+    runMultiResolutionBenchmarks(runner, results);
+    runDecibelBenchmarks(runner, results);
+    runAveragingBenchmarks(runner, results);
+    runResponseCurveBenchmarks(runner, results);
+    return results;
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 17 Oct 2026 2:21:38pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ One measured case. A 'sample' is whatever the benchmark works through per call:
+ samples per channel for the filters, input samples for the FFT, bins for the
+ analyzer path and pixels for the response curve.
+ */
+struct BenchmarkResult
+{
+    // suite is what --suite picks the result by
+    juce::String suite, name;
+    juce::NamedValueSet parameters;
+
+    double nsPerCall { 0 }, nsPerSample { 0 }, cyclesPerSample { 0 };
+};
+
+/**
+ Times a piece of work that processes a known number of samples per call.
+ One untimed round warms up the caches, then the fastest of several timed
+ rounds is kept, which is the least noisy number on a busy machine.
+ Every round works through about the same number of samples, so cases with
+ tiny and huge calls get timed equally well.
+ */
+struct BenchmarkRunner
+{
+    int samplesPerRound { 1 << 16 };
+    int numRounds { 5 };
+
+    // from the nominal clock, there is no portable cycle counter. 0 if the OS doesn't say.
+    double cyclesPerNanosecond { juce::SystemStats::getCpuSpeedInMegahertz() / 1000.0 };
+
+    template<typename Work>
+    BenchmarkResult run(const juce::String& suite, const juce::String& name, int samplesPerCall, Work&& work) const
+    {
+        const auto callsPerRound = juce::jmax(1, samplesPerRound / samplesPerCall);
+
+        for( int i = 0; i < callsPerRound; ++i )
+            work();
+
+        auto best = std::numeric_limits<double>::max();
+
+        for( int round = 0; round < numRounds; ++round )
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for( int i = 0; i < callsPerRound; ++i )
+                work();
+
+            auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            best = juce::jmin(best, seconds);
+        }
+
+        BenchmarkResult result;
+        result.suite = suite;
+        result.name = name;
+        result.nsPerCall = best * 1.0e9 / callsPerRound;
+        result.nsPerSample = result.nsPerCall / samplesPerCall;
+        result.cyclesPerSample = result.nsPerSample * cyclesPerNanosecond;
+        return result;
+    }
+};
+
+//==============================================================================
+juce::Array<BenchmarkResult> runProcessorBenchmarks(const BenchmarkRunner& runner, bool fullMatrix);
+juce::Array<BenchmarkResult> runSmoothingBenchmarks(const BenchmarkRunner& runner);
+juce::Array<BenchmarkResult> runAnalyzerBenchmarks(const BenchmarkRunner& runner);
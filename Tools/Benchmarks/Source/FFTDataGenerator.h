@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+    FFTDataGenerator.h
+    Created: 7 Feb 2024 11:43:08pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/Fifo.h"
+#include "../../../Source/GUI/AnalyzerSettings.h"
+#include "../../../Source/GUI/SpectrumKernels.h"
+
+/**
+ Turns windows of audio into magnitude spectra in decibels, one fifo of frames per output.
+ Output 0 is the left channel (or mid, or the mono sum), output 1 the right channel (or side).
+ 
+ prepare() builds the FFT plans and window tables for every size and window up front,
+ and sizes everything for the largest FFT. After that, changeOrder() and changeWindow()
+ only pick from what's there, so switching never allocates.
+ 
+ The editor's analyzer uses the MultiResolutionAnalyzer, this is the single FFT one
+ the benchmarks measure it against, which is why it lives with them and not in the plugin.
+ */
+template<typename BlockType>
+struct FFTDataGenerator
+{
+    static constexpr int NumOutputs = 2;
+    static constexpr int MinOrder = FFTOrder::order2048;
+    static constexpr int MaxOrder = FFTOrder::order32768;
+    static constexpr int MaxFFTSize = 1 << MaxOrder;
+    
+    /**
+     produces the FFT data from an audio buffer, into output 0.
+     */
+    void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
+    {
+        const auto fftSize = getFFTSize();
+        
+        auto* fftData = fftDataFifos[0].acquireWrite();
+        if( fftData == nullptr )
+            return;
+        
+        auto* readIndex = audioData.getReadPointer(0);
+        std::copy(readIndex, readIndex + fftSize, fftData->begin());
+        
+        renderRealFFTData(*fftData, negativeInfinity);
+        fftDataFifos[0].commitWrite();
+    }
+    
+    /**
+     produces the FFT data from the fftSize samples that end at 'end' in a sample ring,
+     copied straight into a free slot of output 0 and transformed there.
+     returns false if the ring couldn't hand them out (not written yet, or overwritten),
+     or if the fifo is full.
+     */
+    template<typename SampleRing>
+    bool produceFFTDataForRendering(const SampleRing& ring, juce::int64 end, const float negativeInfinity)
+    {
+        const auto fftSize = getFFTSize();
+        
+        auto* fftData = fftDataFifos[0].acquireWrite();
+        if( fftData == nullptr )
+            return false;
+        
+        if( ! ring.read(fftData->data(), end - fftSize, fftSize) )
+            return false;
+        
+        renderRealFFTData(*fftData, negativeInfinity);
+        fftDataFifos[0].commitWrite();
+        return true;
+    }
+    
+    /**
+     produces the FFT data of both channels from two sample rings.
+     
+     LeftRight and MidSide pack the two signals into the real and imaginary part of
+     one complex FFT and pull the two spectra apart afterwards, using the conjugate
+     symmetry real signals have: X[k] = (Z[k] + Z*[N-k]) / 2, Y[k] = (Z[k] - Z*[N-k]) / 2i.
+     That's one FFT of size N for both channels instead of two.
+     MonoSum only needs one real FFT and only fills output 0.
+     */
+    template<typename SampleRing>
+    bool produceFFTDataForRendering(const SampleRing& left,
+                                    const SampleRing& right,
+                                    juce::int64 end,
+                                    const float negativeInfinity,
+                                    AnalyzerMode mode)
+    {
+        const auto fftSize = getFFTSize();
+        
+        auto* first = fftDataFifos[0].acquireWrite();
+        if( first == nullptr )
+            return false;
+        
+        if( ! left.read(first->data(), end - fftSize, fftSize) )
+            return false;
+        
+        if( mode == AnalyzerMode::MonoSum )
+        {
+            if( ! right.read(scratch.data(), end - fftSize, fftSize) )
+                return false;
+            
+            juce::FloatVectorOperations::add(first->data(), scratch.data(), fftSize);
+            juce::FloatVectorOperations::multiply(first->data(), 0.5f, fftSize);
+            
+            renderRealFFTData(*first, negativeInfinity);
+            fftDataFifos[0].commitWrite();
+            return true;
+        }
+        
+        auto* second = fftDataFifos[1].acquireWrite();
+        if( second == nullptr )
+            return false;
+        
+        if( ! right.read(second->data(), end - fftSize, fftSize) )
+            return false;
+        
+        auto* l = first->data();
+        auto* r = second->data();
+        
+        if( mode == AnalyzerMode::MidSide )
+        {
+            for( int i = 0; i < fftSize; ++i )
+            {
+                timeData[i] = { 0.5f * (l[i] + r[i]) * windowTable[i],
+                                0.5f * (l[i] - r[i]) * windowTable[i] };
+            }
+        }
+        else
+        {
+            for( int i = 0; i < fftSize; ++i )
+                timeData[i] = { l[i] * windowTable[i], r[i] * windowTable[i] };
+        }
+        
+        forwardFFT->perform(timeData.data(), spectrum.data(), false);
+        
+        splitTwoRealMagnitudes(spectrum.data(), fftSize, 0, fftSize / 2, l, r);
+        
+        convertToDecibels(*first, negativeInfinity);
+        convertToDecibels(*second, negativeInfinity);
+        
+        fftDataFifos[0].commitWrite();
+        fftDataFifos[1].commitWrite();
+        return true;
+    }
+    
+    /** allocates, so do this before the first frame and off the message thread. */
+    void prepare()
+    {
+        using Window = juce::dsp::WindowingFunction<float>;
+        const Window::WindowingMethod methods[NumWindows] { Window::blackmanHarris, Window::hann, Window::flatTop };
+        
+        for( int o = MinOrder; o <= MaxOrder; ++o )
+        {
+            auto& plan = plans[o - MinOrder];
+            const auto size = 1 << o;
+            
+            plan.fft = std::make_unique<juce::dsp::FFT>(o);
+            
+            for( int w = 0; w < NumWindows; ++w )
+            {
+                plan.windows[w].resize(size);
+                Window::fillWindowingTables(plan.windows[w].data(), size, methods[w], true);
+            }
+        }
+        
+        timeData.assign(MaxFFTSize, {});
+        spectrum.assign(MaxFFTSize, {});
+        scratch.assign(MaxFFTSize, 0.f);
+        
+        // the FFT works in place in the fifo's slots, which need room for the whole transform
+        for( auto& fifo : fftDataFifos )
+            fifo.prepare(static_cast<size_t>(MaxFFTSize * 2));
+        
+        prepared = true;
+        selectPlan();
+    }
+    
+    void changeOrder(FFTOrder newOrder)
+    {
+        jassert(newOrder >= MinOrder && newOrder <= MaxOrder);
+        
+        order = newOrder;
+        selectPlan();
+    }
+    
+    void changeWindow(AnalyzerWindow newWindow)
+    {
+        windowType = newWindow;
+        selectPlan();
+    }
+    
+    FFTOrder getOrder() const { return order; }
+    AnalyzerWindow getWindow() const { return windowType; }
+    //==============================================================================
+    int getFFTSize() const { return 1 << order; }
+    int getNumAvailableFFTDataBlocks(int output = 0) const { return fftDataFifos[output].getNumAvailableForReading(); }
+    //==============================================================================
+    /** the oldest frame, read in place. give it back with releaseFFTData(). nullptr if there is none. */
+    const BlockType* acquireFFTData(int output = 0) { return fftDataFifos[output].acquireRead(); }
+    void releaseFFTData(int output = 0) { fftDataFifos[output].releaseRead(); }
+    
+    int getNumDroppedFFTDataBlocks(int output = 0) const { return fftDataFifos[output].getNumDroppedPushes(); }
+private:
+    /** the first fftSize samples of fftData are the input. */
+    void renderRealFFTData(BlockType& fftData, const float negativeInfinity)
+    {
+        // the transform only reads the first fftSize values, so the rest needn't be cleared
+        const auto fftSize = getFFTSize();
+        
+        // first apply a windowing function to our data
+        juce::FloatVectorOperations::multiply (fftData.data(), windowTable, fftSize);  // [1]
+        
+        // then render our FFT data..
+        forwardFFT->performFrequencyOnlyForwardTransform (fftData.data());  // [2]
+        
+        convertToDecibels(fftData, negativeInfinity);
+    }
+    
+    /** the first fftSize / 2 values of fftData are magnitudes. */
+    void convertToDecibels(BlockType& fftData, const float negativeInfinity)
+    {
+        int numBins = (int)getFFTSize() / 2;
+        
+        //normalize, scrub NaN and inf, and convert to decibels, in one pass
+        magnitudesToDecibels(fftData.data(), numBins, 1.f / float(numBins), negativeInfinity);
+    }
+    
+    /** points forwardFFT and windowTable at the prebuilt ones, the first call builds them all. */
+    void selectPlan()
+    {
+        if( ! prepared )
+            prepare();
+        
+        auto& plan = plans[order - MinOrder];
+        forwardFFT = plan.fft.get();
+        windowTable = plan.windows[windowType].data();
+    }
+    
+    static constexpr int NumOrders = MaxOrder - MinOrder + 1;
+    static constexpr int NumWindows = 3;
+    
+    struct Plan
+    {
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::array<std::vector<float>, NumWindows> windows;
+    };
+    
+    std::array<Plan, NumOrders> plans;
+    bool prepared { false };
+    
+    FFTOrder order { FFTOrder::order2048 };
+    AnalyzerWindow windowType { AnalyzerWindow::BlackmanHarris };
+    const juce::dsp::FFT* forwardFFT { nullptr };
+    const float* windowTable { nullptr };
+    
+    std::vector<float> scratch;
+    std::vector<juce::dsp::Complex<float>> timeData, spectrum;
+    
+    // a frame is drawn on the pass it's made, so the fifos never need to hold many
+    std::array<Fifo<BlockType, 4>, NumOutputs> fftDataFifos;
+};
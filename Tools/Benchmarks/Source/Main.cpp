@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 2:21:38pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+
+namespace
+{
+void printUsage()
+{
+    std::cout << "usage: Benchmarks [--full] [--suite <name>] [--json <file>]\n\n"
+                 "  --full   processBlock over every block size, sample rate, slope and bypass\n"
+                 "           combination instead of one sweep at a time\n"
+                 "  --suite  only run processor, smoothing or analyzer\n"
+                 "  --json   where the results go, defaults to benchmark-results.json" << std::endl;
+}
+
+void printResults(const juce::Array<BenchmarkResult>& results)
+{
+    for( const auto& result : results )
+    {
+        std::cout << "  " << (result.suite + ": " + result.name).paddedRight(' ', 72)
+                  << juce::String(result.nsPerSample, 3).paddedLeft(' ', 10) << " ns/sample"
+                  << juce::String(result.cyclesPerSample, 2).paddedLeft(' ', 10) << " cycles/sample"
+                  << std::endl;
+    }
+}
+
+juce::var toJson(const juce::Array<BenchmarkResult>& results)
+{
+    juce::Array<juce::var> cases;
+
+    for( const auto& result : results )
+    {
+        juce::DynamicObject::Ptr parameters = new juce::DynamicObject();
+        for( const auto& parameter : result.parameters )
+            parameters->setProperty(parameter.name, parameter.value);
+
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("suite", result.suite);
+        entry->setProperty("name", result.name);
+        entry->setProperty("parameters", parameters.get());
+        entry->setProperty("nsPerCall", result.nsPerCall);
+        entry->setProperty("nsPerSample", result.nsPerSample);
+        entry->setProperty("cyclesPerSample", result.cyclesPerSample);
+        cases.add(entry.get());
+    }
+
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("cpuMHz", juce::SystemStats::getCpuSpeedInMegahertz());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("juce", juce::SystemStats::getJUCEVersion());
+   #if JUCE_DEBUG
+    root->setProperty("build", "Debug");
+   #else
+    root->setProperty("build", "Release");
+   #endif
+    root->setProperty("results", cases);
+
+    return root.get();
+}
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // the processor's APVTS and the analyzer need a message manager around
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    if( args.containsOption("--help|-h") )
+    {
+        printUsage();
+        return 0;
+    }
+
+    const auto suite = args.getValueForOption("--suite");
+    auto shouldRun = [&suite](const juce::String& name) { return suite.isEmpty() || suite == name; };
+
+    auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.containsOption("--json")
+                                                                          ? args.getValueForOption("--json")
+                                                                          : juce::String("benchmark-results.json"));
+
+    BenchmarkRunner runner;
+    juce::Array<BenchmarkResult> results;
+
+    auto add = [&results](const juce::Array<BenchmarkResult>& suiteResults)
+    {
+        printResults(suiteResults);
+        results.addArray(suiteResults);
+    };
+
+    if( shouldRun("processor") )
+        add(runProcessorBenchmarks(runner, args.containsOption("--full")));
+    if( shouldRun("smoothing") )
+        add(runSmoothingBenchmarks(runner));
+    if( shouldRun("analyzer") )
+        add(runAnalyzerBenchmarks(runner));
+
+    if( results.isEmpty() )
+    {
+        printUsage();
+        return 1;
+    }
+
+    if( ! jsonFile.replaceWithText(juce::JSON::toString(toJson(results))) )
+    {
+        std::cerr << "can't write " << jsonFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "wrote " << results.size() << " results to " << jsonFile.getFullPathName() << std::endl;
+    return 0;
+}
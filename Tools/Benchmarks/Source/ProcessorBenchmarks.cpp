@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.cpp
+    Created: 17 Oct 2026 4:30:52pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "../../../Source/PluginProcessor.h"
+
+namespace
+{
+constexpr std::array<int, 10> BlockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192 };
+constexpr std::array<double, 8> SampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0, 352800.0, 384000.0 };
+constexpr std::array<Slope, 4> Slopes { Slope_12, Slope_24, Slope_36, Slope_48 };
+
+// bit i bypasses ChainPositions i
+constexpr int NumBypassCombinations = 1 << NumChainPositions;
+
+struct ProcessorCase
+{
+    double sampleRate { 48000.0 };
+    int blockSize { 512 };
+    Slope lowCutSlope { Slope_48 }, highCutSlope { Slope_48 };
+    int bypassed { 0 };
+
+    bool isBypassed(ChainPositions band) const { return (bypassed & (1 << band)) != 0; }
+
+    juce::String getName() const
+    {
+        juce::String name;
+        name << juce::String(sampleRate / 1000.0, 1) << "k, "
+             << blockSize << " samples, "
+             << "slopes " << (12 + 12 * lowCutSlope) << "/" << (12 + 12 * highCutSlope);
+
+        if( bypassed != 0 )
+        {
+            name << ", bypassed";
+            if( isBypassed(ChainPositions::LowCut) )  name << " LowCut";
+            if( isBypassed(ChainPositions::Peak) )    name << " Peak";
+            if( isBypassed(ChainPositions::HighCut) ) name << " HighCut";
+        }
+
+        return name;
+    }
+};
+
+void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterID, float value)
+{
+    auto* parameter = apvts.getParameter(parameterID);
+    jassert(parameter != nullptr);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+BenchmarkResult runCase(const BenchmarkRunner& runner, SimpleEQAudioProcessor& processor, const ProcessorCase& processorCase)
+{
+    auto& apvts = processor.apvts;
+
+    setParameter(apvts, "LowCut Freq", 80.f);
+    setParameter(apvts, "HighCut Freq", 12000.f);
+    setParameter(apvts, "Peak Freq", 1000.f);
+    setParameter(apvts, "Peak Gain", 6.f);
+    setParameter(apvts, "LowCut Slope", static_cast<float>(processorCase.lowCutSlope));
+    setParameter(apvts, "HighCut Slope", static_cast<float>(processorCase.highCutSlope));
+    setParameter(apvts, "LowCut Bypassed", processorCase.isBypassed(ChainPositions::LowCut) ? 1.f : 0.f);
+    setParameter(apvts, "Peak Bypassed", processorCase.isBypassed(ChainPositions::Peak) ? 1.f : 0.f);
+    setParameter(apvts, "HighCut Bypassed", processorCase.isBypassed(ChainPositions::HighCut) ? 1.f : 0.f);
+
+    // designs the coefficients for these settings before returning
+    processor.prepareToPlay(processorCase.sampleRate, processorCase.blockSize);
+
+    juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), processorCase.blockSize);
+    juce::MidiBuffer midi;
+
+    juce::Random random;
+    for( int channel = 0; channel < buffer.getNumChannels(); ++channel )
+        for( int i = 0; i < buffer.getNumSamples(); ++i )
+            buffer.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+
+    auto result = runner.run("processor", processorCase.getName(), processorCase.blockSize, [&]
+    {
+        processor.processBlock(buffer, midi);
+    });
+
+    result.parameters.set("sampleRate", processorCase.sampleRate);
+    result.parameters.set("blockSize", processorCase.blockSize);
+    result.parameters.set("numChannels", buffer.getNumChannels());
+    result.parameters.set("lowCutSlope", 12 + 12 * processorCase.lowCutSlope);
+    result.parameters.set("highCutSlope", 12 + 12 * processorCase.highCutSlope);
+    result.parameters.set("lowCutBypassed", processorCase.isBypassed(ChainPositions::LowCut));
+    result.parameters.set("peakBypassed", processorCase.isBypassed(ChainPositions::Peak));
+    result.parameters.set("highCutBypassed", processorCase.isBypassed(ChainPositions::HighCut));
+
+    processor.releaseResources();
+    return result;
+}
+}
+
+/**
+ By default block size x sample rate with every band on at 48db, then every
+ slope x bypass combination at 48k / 512. fullMatrix runs all of it against
+ all of it, which is a little over 10000 cases.
+ */
+juce::Array<BenchmarkResult> runProcessorBenchmarks(const BenchmarkRunner& runner, bool fullMatrix)
+{
+    SimpleEQAudioProcessor processor;
+    juce::Array<BenchmarkResult> results;
+
+    if( fullMatrix )
+    {
+        for( auto sampleRate : SampleRates )
+            for( auto blockSize : BlockSizes )
+                for( auto lowCutSlope : Slopes )
+                    for( auto highCutSlope : Slopes )
+                        for( int bypassed = 0; bypassed < NumBypassCombinations; ++bypassed )
+                            results.add(runCase(runner, processor, { sampleRate, blockSize, lowCutSlope, highCutSlope, bypassed }));
+
+        return results;
+    }
+
+    for( auto sampleRate : SampleRates )
+    {
+        for( auto blockSize : BlockSizes )
+        {
+            ProcessorCase processorCase;
+            processorCase.sampleRate = sampleRate;
+            processorCase.blockSize = blockSize;
+            results.add(runCase(runner, processor, processorCase));
+        }
+    }
+
+    for( auto lowCutSlope : Slopes )
+    {
+        for( auto highCutSlope : Slopes )
+        {
+            for( int bypassed = 0; bypassed < NumBypassCombinations; ++bypassed )
+            {
+                ProcessorCase processorCase;
+                processorCase.lowCutSlope = lowCutSlope;
+                processorCase.highCutSlope = highCutSlope;
+                processorCase.bypassed = bypassed;
+                results.add(runCase(runner, processor, processorCase));
+            }
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SmoothingBenchmarks.cpp
+    Created: 17 Oct 2026 2:21:38pm
+    Author:  Ulf Larsson
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+#include "../../../Source/DSP/CoefficientDesigner.h"
+#include "../../../Source/DSP/CoefficientSmoother.h"
+#include "../../../Source/DSP/SIMDFilterEngine.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr int BlockSize = 512;
+constexpr int NumChannels = 2;
+
+/**
+ Stereo chain with every band active (48db cuts and the peak), fed noise.
+ Every block retargets all bands, so the smoother never settles and
+ each block pays the full cost of gliding.
+ */
+struct SmoothingFixture
+{
+    explicit SmoothingFixture(CutCoefficientTable::Ptr table = nullptr)
+    {
+        buffer.setSize(NumChannels, BlockSize);
+
+        juce::Random random;
+        for( int channel = 0; channel < NumChannels; ++channel )
+            for( int i = 0; i < BlockSize; ++i )
+                buffer.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+
+        filterEngine.prepare({ SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) });
+
+        ChainSettings settings;
+        settings.lowCutFreq = 80.f;
+        settings.lowCutSlope = Slope::Slope_48;
+        settings.peakFreq = 500.f;
+        settings.peakGainInDecibels = 6.f;
+        settings.highCutFreq = 16000.f;
+        settings.highCutSlope = Slope::Slope_48;
+        targets[0] = designFilterCoefficients(settings, SampleRate);
+
+        settings.lowCutFreq = 400.f;
+        settings.peakFreq = 4000.f;
+        settings.peakGainInDecibels = -6.f;
+        settings.highCutFreq = 6000.f;
+        targets[1] = designFilterCoefficients(settings, SampleRate);
+
+        filterEngine.setCoefficients(targets[0]);
+
+        smoother.prepare(SampleRate, std::move(table));
+        for( int band = 0; band < NumChainPositions; ++band )
+            smoother.jumpTo(targets[0], band);
+    }
+
+    void processStatic()
+    {
+        juce::dsp::AudioBlock<float> block(buffer);
+        filterEngine.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+    /** the same loop SimpleEQAudioProcessor::processSmoothed() runs. */
+    void processSmoothed(size_t interval)
+    {
+        const auto& target = targets[nextTarget];
+        nextTarget ^= 1;
+
+        for( int band = 0; band < NumChainPositions; ++band )
+            smoother.glideTo(target, band);
+
+        juce::dsp::AudioBlock<float> block(buffer);
+
+        for( size_t start = 0; start < BlockSize; start += interval )
+        {
+            auto length = juce::jmin(interval, BlockSize - start);
+
+            if( smoother.isSmoothing() )
+            {
+                auto changedBands = smoother.advance(static_cast<int>(length));
+                const auto& coefficients = smoother.getCoefficients();
+
+                if( changedBands & (1 << ChainPositions::LowCut) )
+                    filterEngine.rampLowCut(coefficients.lowCut, length);
+                if( changedBands & (1 << ChainPositions::Peak) )
+                    filterEngine.rampPeak(coefficients.peak, length);
+                if( changedBands & (1 << ChainPositions::HighCut) )
+                    filterEngine.rampHighCut(coefficients.highCut, length);
+            }
+
+            auto subBlock = block.getSubBlock(start, length);
+            filterEngine.process(juce::dsp::ProcessContextReplacing<float>(subBlock));
+        }
+    }
+
+    juce::AudioBuffer<float> buffer;
+    SIMDFilterEngine filterEngine;
+    CoefficientSmoother smoother;
+    std::array<FilterCoefficients, 2> targets;
+    int nextTarget { 1 };
+};
+}
+
+juce::Array<BenchmarkResult> runSmoothingBenchmarks(const BenchmarkRunner& runner)
+{
+    juce::Array<BenchmarkResult> results;
+
+    {
+        SmoothingFixture fixture;
+        results.add(runner.run("smoothing", "static coefficients", BlockSize, [&] { fixture.processStatic(); }));
+    }
+
+    // 1 is a redesign every sample, what smoothing costs without the ramps
+    for( size_t interval : { 64, 32, 16, 1 } )
+    {
+        SmoothingFixture fixture;
+        auto result = runner.run("smoothing", "redesign every " + juce::String(static_cast<int>(interval)),
+                                 BlockSize,
+                                 [&] { fixture.processSmoothed(interval); });
+        result.parameters.set("interval", static_cast<int>(interval));
+        result.parameters.set("table", false);
+        results.add(result);
+    }
+
+    // same again with the cuts looked up instead of designed
+    juce::SharedResourcePointer<CutCoefficientTableCache> tables;
+    auto table = tables->getTable(SampleRate);
+
+    for( size_t interval : { 64, 32, 16, 1 } )
+    {
+        SmoothingFixture fixture(table);
+        auto result = runner.run("smoothing", "table lookups, redesign every " + juce::String(static_cast<int>(interval)),
+                                 BlockSize,
+                                 [&] { fixture.processSmoothed(interval); });
+        result.parameters.set("interval", static_cast<int>(interval));
+        result.parameters.set("table", true);
+        results.add(result);
+    }
+
+    return results;
+}